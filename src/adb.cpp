@@ -23,107 +23,289 @@
  *******************************************************************************/
 
 #include "adb.hpp"
+#include "adbshell.hpp"
+#include "adbsync.hpp"
+#include "compressedpush.hpp"
+#include "adbstream.hpp"
+#include "capturefollower.hpp"
+#include "adbtrace.hpp"
 
 #include <QProcess>
 #include <QFile>
 #include <QDir>
 #include <QCoreApplication>
+#include <QTemporaryFile>
+#include <QElapsedTimer>
+#include <QCryptographicHash>
+#include <QThread>
+#include <QRegularExpression>
 
 #include <sstream>
 #include <format>
 #include <fstream>
-#include <thread>
-#include <chrono>
+#include <algorithm>
+#include <map>
 #include "common.hpp"
-#include "ProgressBar.hpp"
+
+// Reports transfer progress through the handler set on ADB, if any. ADB
+// runs off the GUI thread, the window shows progress from the handler.
+class TransferProgress {
+public:
+	TransferProgress(const ADB::ProgressHandler& handler, QString text)
+		: handler(handler), text(text), percent(0)
+	{
+	}
+
+	// Both return false once the handler cancels the transfer
+	bool update(int percent) {
+		this->percent = percent;
+		return !handler || handler(text, percent);
+	}
+
+	bool setText(QString text) {
+		this->text = text;
+		return !handler || handler(text, percent);
+	}
+
+private:
+	const ADB::ProgressHandler& handler;
+	QString text;
+	int percent;
+};
+
+static const char* ABIS[] = { "arm64-v8a", "armeabi-v7a", "x86_64", "x86" };
+
+static QFileInfo LocalReplayApk() {
+	return QFileInfo(QDir(QCoreApplication::applicationDirPath()), "tools/replay-debug.apk");
+}
+
+static QFileInfo LocalRecordLayer(const std::string& abi) {
+	return QFileInfo(QDir(QCoreApplication::applicationDirPath()), QString("layer/%1/libVkLayer_gfxreconstruct.so").arg(abi.c_str()));
+}
 
 static std::string rstrip(const std::string & s) {
 	return s.substr(0, s.find_last_not_of(" \t\n\r\f\v") + 1);
 }
 
-QString ADB::runProgram(const QString& program, const QStringList& args) {
+// Runs a program to completion, the caller records it in the trace
+static QString execute(const QString& program, const QStringList& args, int& status) {
 	QProcess p;
 	p.setProgram(program);
 	p.setArguments(args);
 	p.start();
 	p.waitForFinished(-1);
 
-	QString output = QString::fromUtf8(p.readAllStandardOutput());
+	status = p.exitStatus() == QProcess::NormalExit ? p.exitCode() : -1;
+	return QString::fromUtf8(p.readAllStandardOutput());
+}
+
+QString ADB::runProgram(const QString& program, const QStringList& args) {
+	AdbTrace::Scope trace(AdbTrace::Program, serial, program + " " + args.join(' '));
+
+	int status = -1;
+	QString output = execute(program, args, status);
+	trace.SetBytes(output.size());
+	trace.SetStatus(status);
 	return output.trimmed();
 }
 
-bool ADB::pushFileStreaming(std::string serial, QFileInfo src, QString dst)
+bool ADB::transferFile(QFileInfo src, QString dst)
+{
+	if (compression && pushFileCompressed(src, dst))
+		return true;
+	return pushFileSync(src, dst);
+}
+
+bool ADB::pushFileSync(QFileInfo src, QString dst)
 {
-	QProcess p;
 	QFile f(src.absoluteFilePath());
 	if (!f.open(QIODevice::ReadOnly))
 		return false;
 
-	if (this->ShellCommand(QString("touch %1 || echo failed $?").arg(dst)).contains("failed")) {
-		LOGD("Failed to create remote file %s", dst.toStdString().c_str());
+	LOGD("Transferring %s to %s", src.absoluteFilePath().toStdString().c_str(), dst.toStdString().c_str());
+
+	TransferProgress progress(progressHandler, QString("Transferring %1").arg(src.fileName()));
+	AdbTrace::Scope trace(AdbTrace::Push, serial, dst);
+
+	QElapsedTimer timer;
+	timer.start();
+
+	AdbSync sync(serial);
+	bool result = sync.Push(f, dst, 0100644, [&](qint64 done, qint64 total) {
+		trace.SetBytes(done);
+		return progress.update(total ? done * 100 / total : 100);
+	});
+	trace.SetStatus(result ? 0 : 1);
+
+	// Remember the raw link rate so compressed pushes can tell if they pay off
+	if (result && f.size() >= (16 << 20))
+		syncThroughput = f.size() / std::max(timer.elapsed() / 1000.0, 0.001);
+
+	return result;
+}
+
+bool ADB::pushFileCompressed(QFileInfo src, QString dst)
+{
+	QFile f(src.absoluteFilePath());
+	if (!f.open(QIODevice::ReadOnly))
 		return false;
-	}
 
-	LOGD("Transferring %s to %s", src.absoluteFilePath().toStdString().c_str(), dst.toStdString().c_str());
+	LOGD("Transferring %s to %s compressed", src.absoluteFilePath().toStdString().c_str(), dst.toStdString().c_str());
 
-	p.setProgram("adb");
-	p.setArguments({ "-s", serial.c_str(), "exec-in", "sh", "-c", QString("cat > %1").arg(dst) });
-	p.setProcessChannelMode(QProcess::MergedChannels);
-	p.start();
+	TransferProgress progress(progressHandler, QString("Transferring %1").arg(src.fileName()));
+
+	AdbTrace::Scope trace(AdbTrace::Push, serial, dst + " (gzip)");
+	CompressedPush push(serial);
+	CompressedPush::Result result = push.Push(f, dst, syncThroughput, [&](qint64 done, qint64 total) {
+		trace.SetBytes(done);
+		return progress.update(total ? done * 100 / total : 100);
+	});
+	trace.SetStatus(static_cast<int>(result));
 
-	if (!p.waitForStarted())
+	if (result == CompressedPush::Result::NotWorthwhile)
+		LOGD("Compression ratio %.2f does not pay off, falling back to raw transfer", push.Ratio());
+	else if (result == CompressedPush::Result::Failed)
+		LOGD("Compressed transfer failed, falling back to raw transfer");
+
+	return result == CompressedPush::Result::Done;
+}
+
+bool ADB::pullFileSync(QString src, QFileInfo dst)
+{
+	QFile f(dst.absoluteFilePath());
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
 		return false;
 
-	const qint64 totalSize = f.size();
-	qint64 sent = 0;
+	LOGD("Transferring %s to %s", src.toStdString().c_str(), dst.absoluteFilePath().toStdString().c_str());
 
-	QByteArray buf;
-	buf.resize(1 << 16);
-
-	ProgressBar progress(QString("Transferring %1").arg(src.fileName()));
-	
-	while (true) {
-		qint64 off = 0;
-		const qint64 n = f.read(buf.data(), buf.size());
-
-		if (n < 0) return false;
-		if (n == 0) break;
-
-		while (off < n) {
-			const qint64 w = p.write(buf.constData() + off, n - off);
-			if (w <= 0) return false;
-			if (!p.waitForBytesWritten(-1)) return false;
-			off += w;
-			sent += w;
-			progress.update(sent * 100 / totalSize);
-		}
+	TransferProgress progress(progressHandler, QString("Transferring %1").arg(dst.fileName()));
+
+	AdbTrace::Scope trace(AdbTrace::Pull, serial, src);
+	AdbSync sync(serial);
+	bool result = sync.Pull(src, f, [&](qint64 done, qint64 total) {
+		trace.SetBytes(done);
+		return progress.update(total ? done * 100 / total : 100);
+	});
+	trace.SetStatus(result ? 0 : 1);
+
+	if (!result)
+		f.remove();
+	return result;
+}
+
+qint64 ADB::verifiedOffset(QFile& part, QString src)
+{
+	// Keep what is already on disk only if its last block still matches the device
+	const qint64 BLOCK = 1 << 20;
+	const qint64 offset = part.size() / BLOCK * BLOCK;
+	if (offset == 0)
+		return 0;
+
+	if (!part.seek(offset - BLOCK))
+		return 0;
+	const QByteArray local = QCryptographicHash::hash(part.read(BLOCK), QCryptographicHash::Sha1).toHex();
+	const QByteArray remote = AdbStream(serial).HashRange(src, offset - BLOCK, BLOCK);
+	if (local != remote) {
+		LOGD("Partial file no longer matches %s, starting over", src.toStdString().c_str());
+		return 0;
 	}
+	return offset;
+}
 
-	qint64 lastRemoteSize = 0;
-	qint64 currentRemoteSize = 0;
+// Unsupported means nothing was ever streamed: no dd, no shell v2, a dd
+// without byte offsets or a file dd cannot read, where a sync pull may still
+// work. Once bytes arrived a failure keeps the .part file and leaves dst
+// alone, so the next call resumes instead of starting over.
+ADB::PullResult ADB::pullFileResumable(QString src, QFileInfo dst)
+{
+	const qint64 totalSize = this->GetRemoteSize(src);
+	if (totalSize <= 0 || !this->GetProfile().HasApplet("dd"))
+		return PullResult::Unsupported;
 
-	do {
-		lastRemoteSize = currentRemoteSize;
-		currentRemoteSize = this->GetRemoteSize(dst);
-		std::this_thread::sleep_for(std::chrono::seconds(1));
-	} while (currentRemoteSize < totalSize && currentRemoteSize != lastRemoteSize);
+	QFile part(dst.absoluteFilePath() + ".part");
+	if (!part.open(QIODevice::ReadWrite))
+		return PullResult::Failed;
 
-	p.closeWriteChannel();
-	p.waitForFinished(-1);
-	progress.close();
+	qint64 offset = verifiedOffset(part, src);
+	if (!part.resize(offset) || !part.seek(offset))
+		return PullResult::Failed;
+
+	LOGD("Transferring %s to %s from offset %lld", src.toStdString().c_str(), dst.absoluteFilePath().toStdString().c_str(), offset);
+
+	TransferProgress progress(progressHandler, QString("Transferring %1").arg(dst.fileName()));
+
+	const qint64 startOffset = offset;
+	QElapsedTimer timer;
+	timer.start();
+	qint64 lastUpdate = -1000;
+	auto sink = [&](const char* data, qint64 size) {
+		if (part.write(data, size) != size)
+			return false;
+		offset += size;
+
+		const qint64 elapsed = timer.elapsed();
+		if (elapsed - lastUpdate >= 200) {
+			lastUpdate = elapsed;
+			const double rate = (offset - startOffset) / std::max(elapsed / 1000.0, 0.001);
+			const qint64 eta = rate > 0 ? static_cast<qint64>((totalSize - offset) / rate) : 0;
+			progress.setText(QString("Transferring %1\n%2 MB/s, %3:%4 left").arg(dst.fileName())
+				.arg(rate / 1e6, 0, 'f', 1).arg(eta / 60).arg(eta % 60, 2, 10, QChar('0')));
+			return progress.update(offset * 100 / totalSize);
+		}
+		return true;
+	};
+
+	AdbTrace::Scope trace(AdbTrace::Pull, serial, src + " (resumable)");
+	AdbStream stream(serial);
+	const int RETRIES = 5;
+	int failures = 0;
+	while (offset < totalSize && failures < RETRIES) {
+		const qint64 before = offset;
+		const AdbStream::Result result = stream.ReadRange(src, offset, -1, sink);
+		if (result == AdbStream::Result::Done)
+			break;
+		part.flush();
+
+		// dd or the local file failing will fail again, and a device that
+		// never sent a byte is not coming back mid-transfer
+		if (result == AdbStream::Result::Failed || offset == startOffset) {
+			LOGD("Pull of %s failed at %lld", src.toStdString().c_str(), offset);
+			break;
+		}
 
-	LOGD("%lld out of %lld transferred", currentRemoteSize, totalSize);
+		// Only consecutive attempts without progress count against the limit
+		failures = offset > before ? 0 : failures + 1;
+		LOGD("Pull of %s interrupted at %lld, resuming", src.toStdString().c_str(), offset);
+		QThread::msleep(1000);
+	}
+	part.close();
+	trace.SetBytes(offset - startOffset);
+	trace.SetStatus(offset == totalSize ? 0 : 1);
+
+	LOGD("%lld out of %lld transferred", offset, totalSize);
+	if (offset == 0) {
+		part.remove();
+		return PullResult::Unsupported;
+	}
+	if (offset != totalSize)
+		return PullResult::Failed;
 
-	return currentRemoteSize == totalSize;
+	QFile::remove(dst.absoluteFilePath());
+	return part.rename(dst.absoluteFilePath()) ? PullResult::Done : PullResult::Failed;
 }
 
-ADB::ADB() {
+ADB::ADB()
+	: compression(false), syncThroughput(0.0), profileValid(false)
+{
 }
 
 ADB::~ADB() {
 }
 
-std::vector<std::string> ADB::GetDevices() {
+// Apps started from Finder get a minimal PATH without Homebrew or the SDK.
+// setenv() is not thread safe, so this runs once on the main thread before
+// any ADB work starts on a worker.
+void ADB::SetupEnvironment() {
 #if defined(__APPLE__)
 	std::string PATH =
 		"/usr/local/bin:"
@@ -142,12 +324,31 @@ std::vector<std::string> ADB::GetDevices() {
 	}
 	setenv("PATH", PATH.c_str(), 1);
 #endif
+}
+
+std::vector<std::string> ADB::GetDevices() {
+	std::vector<std::string> devices;
+	std::vector<AdbClient::Device> list;
+	bool native = client.ListDevices(list);
+	if (!native) {
+		LOGD("adb server not reachable, starting it");
+		runProgram("adb", { "start-server" });
+		native = client.ListDevices(list);
+	}
+
+	if (native) {
+		for (const AdbClient::Device& device : list) {
+			if (device.state == "device")
+				devices.push_back(device.serial);
+		}
+		return devices;
+	}
+
 	std::string output = runProgram("adb", {"devices"}).toStdString();
 
 	if (output.empty())
 		LOGE("adb not found!");
 
-	std::vector<std::string> devices;
 	std::istringstream iss(output);
 	std::string line;
 	while (std::getline(iss, line, '\n')) {
@@ -162,18 +363,85 @@ std::vector<std::string> ADB::GetDevices() {
 }
 
 bool ADB::ConnectDevice(std::string serial) {
-	runProgram("adb", { "connect", serial.c_str()});
+	QString message;
+	if (client.IsAvailable()) {
+		client.Connect(serial, message);
+		LOGD("adb connect %s: %s", serial.c_str(), message.toStdString().c_str());
+	}
+	else {
+		runProgram("adb", { "connect", serial.c_str()});
+	}
 
 	std::vector<std::string> devices = this->GetDevices();
 	if (std::find(devices.begin(), devices.end(), serial) == devices.end())
 		return false;
 
+	if (this->serial != serial || !shell) {
+		shell = std::make_unique<AdbShell>(serial);
+		manifest = std::make_unique<DeployManifest>(serial);
+		profileValid = false;
+	}
 	this->serial = serial;
+
+	// Hash what may be deployed while the rest of the setup talks to the device
+	DeployManifest::LocalHash(LocalReplayApk().absoluteFilePath());
+	for (const char* abi : ABIS)
+		DeployManifest::LocalHash(LocalRecordLayer(abi).absoluteFilePath());
+
 	return true;
 }
 
+void ADB::Disconnect() {
+	shell.reset();
+	manifest.reset();
+	serial.clear();
+	profileValid = false;
+}
+
+std::string ADB::GetSerial() const {
+	return serial;
+}
+
 QString ADB::ShellCommand(QString cmd) {
-	return runProgram("adb", { "-s", serial.c_str(), "shell", cmd });
+	QString output;
+	shellCommand(cmd, output);
+	return output;
+}
+
+// Returns false when the command may have reached the device but its result
+// was lost. Such a command is not run a second time: it could repeat an
+// install, a move or a patch.
+bool ADB::shellCommand(const QString& cmd, QString& output) {
+	AdbTrace::Scope trace(AdbTrace::Shell, serial, cmd);
+
+	int exitCode = -1;
+	bool sent = false;
+	if (shell && shell->Run(cmd, output, &exitCode, &sent)) {
+		trace.SetBytes(output.size());
+		trace.SetStatus(exitCode);
+		return true;
+	}
+	if (sent)
+		return false;
+
+	LOGD("Shell session unavailable, falling back to one-shot shell");
+	AdbClient::ShellResult result;
+	if (client.Shell(serial, cmd, result)) {
+		trace.SetBytes(result.out.size());
+		trace.SetStatus(result.exitCode);
+		output = QString::fromUtf8(result.out).trimmed();
+		return true;
+	}
+	if (result.started)
+		return false;
+
+	// The adb program is the last resort, still one Shell event
+	int status = -1;
+	output = execute("adb", { "-s", serial.c_str(), "shell", cmd }, status);
+	trace.SetBytes(output.size());
+	trace.SetStatus(status);
+	output = output.trimmed();
+	return true;
 }
 
 std::string ADB::ShellCommand(std::string cmd) {
@@ -185,19 +453,34 @@ std::string ADB::ShellCommand(const char* cmd) {
 }
 
 QString ADB::ShellCommandPrivileged(QString cmd) {
-	QString result;
+	// Printed by the escalated shell before the command runs, so a failing
+	// command is not mistaken for a failed escalation
+	static const QString TAG = "__GFXR_PRIVILEGED__";
 
 	LOGD("Running previleged command \"%s\"", cmd.toStdString().c_str());
 
-	result = this->ShellCommand(QString("su 0 sh -c '%1' || echo ShellCommandPrivileged $?").arg(cmd));
-	if (!result.contains("ShellCommandPrivileged"))
-		return result;
-	LOGD("Failed to run previleged command as root");
+	for (int attempt = 0; attempt < 2; attempt++) {
+		QString wrapper;
+		switch (this->GetProfile().escalation) {
+		case DeviceProfile::Escalation::Root:
+			wrapper = "su 0 sh -c %1";
+			break;
+		case DeviceProfile::Escalation::RunAs:
+			wrapper = "run-as com.lunarg.gfxreconstruct.replay sh -c %1";
+			break;
+		default:
+			return this->ShellCommand(cmd);
+		}
 
-	result = this->ShellCommand(QString("run-as com.lunarg.gfxreconstruct.replay sh -c '%1' || echo ShellCommandPrivileged $?").arg(cmd));
-	if (!result.contains("ShellCommandPrivileged"))
-		return result;
-	LOGD("Failed to run previleged command as gfxr");
+		QString result;
+		if (!shellCommand(wrapper.arg(AdbShell::Quote(QString("echo %1; %2").arg(TAG, cmd))), result))
+			return QString();
+		if (result.startsWith(TAG))
+			return result.mid(TAG.size()).trimmed();
+
+		LOGD("Failed to escalate privilege, probing device again");
+		profileValid = false;
+	}
 
 	return this->ShellCommand(cmd);
 }
@@ -210,30 +493,105 @@ std::string ADB::ShellCommandPrivileged(const char* cmd) {
 	return this->ShellCommandPrivileged(std::string(cmd));
 }
 
+const DeviceProfile& ADB::GetProfile() {
+	if (profileValid)
+		return profile;
+
+	// Keep probing on later calls if the shell did not answer this time
+	profileValid = DeviceProfile::Parse(this->ShellCommand(DeviceProfile::ProbeCommand()), profile);
+	if (!profileValid)
+		LOGD("Failed to probe device capabilities");
+
+	LOGD("Device %s: root %d, escalation %d, SELinux %s, %lld toybox applets, %lld bytes free on /sdcard",
+		serial.c_str(), profile.root, static_cast<int>(profile.escalation), profile.selinux.toStdString().c_str(),
+		static_cast<long long>(profile.applets.size()), profile.sdcardFree);
+
+	return profile;
+}
+
 std::vector<std::string> ADB::GetPackages() {
 	std::vector<std::string> packages;
-	std::string raw = this->ShellCommand("pm list packages -3");
-	std::istringstream iss(raw);
-	std::string line;
-	while (std::getline(iss, line, '\n')) {
-		std::string package = rstrip(line.substr(strlen("package:")));
-		if (GetAppLibDir(package).starts_with("/data/app/"))
-			packages.push_back(package);
-	}
+	this->GetPackages([&packages](const std::string& package) {
+		packages.push_back(package);
+		return true;
+	});
 	return packages;
 }
 
+void ADB::GetPackages(std::function<bool(const std::string&)> callback) {
+	std::vector<PackageCache::Package> packages;
+	if (!loadPackages(packages))
+		return;
+
+	LOGD("package num %zu", packages.size());
+	for (const PackageCache::Package& package : packages) {
+		if (package.libDir.starts_with("/data/app/") && !callback(package.name))
+			return;
+	}
+}
+
 std::string ADB::GetCurrentApp() {
 	return this->ShellCommand("dumpsys activity activities | grep mResumedActivity | sed 's/.*u0 //;s/\\/.*//;s/ .*//'");
 }
 
+std::string ADB::GetLauncherActivity(std::string package) {
+	PackageCache::Package info;
+	if (findPackage(package, info) && !info.activity.empty())
+		return info.activity;
+
+	std::string cmd = std::format("cmd package resolve-activity "
+		"-a android.intent.action.MAIN "
+		"-c android.intent.category.LAUNCHER "
+		"--brief {} | tail -n 1 | cut -d '/' -f2", package);
+	return this->ShellCommand(cmd);
+}
+
+bool ADB::loadPackages(std::vector<PackageCache::Package>& packages) {
+	PackageCache& cache = PackageCache::getInstance();
+	QString fingerprint = this->ShellCommand(PackageCache::FingerprintCommand());
+	if (cache.Get(serial, fingerprint, packages))
+		return true;
+
+	QString raw = this->ShellCommand(PackageCache::CollectCommand());
+	if (!PackageCache::Parse(raw, packages, fingerprint)) {
+		LOGD("Failed to collect package metadata");
+		return false;
+	}
+
+	cache.Put(serial, fingerprint, packages);
+	return true;
+}
+
+bool ADB::findPackage(const std::string& package, PackageCache::Package& info) {
+	std::vector<PackageCache::Package> packages;
+	if (!loadPackages(packages))
+		return false;
+
+	auto it = std::find_if(packages.begin(), packages.end(), [&package](const PackageCache::Package& p) {
+		return p.name == package;
+	});
+	if (it == packages.end())
+		return false;
+
+	info = *it;
+	return true;
+}
+
 std::string ADB::GetAppAbi(std::string package) {
+	PackageCache::Package info;
+	if (findPackage(package, info) && !info.abi.empty())
+		return info.abi;
+
 	std::string cmd = std::format("dumpsys package {} | grep primaryCpuAbi | cut -d= -f2", package);
 	std::string abi = this->ShellCommand(cmd);
 	return abi;
 }
 
 std::string ADB::GetAppLibDir(std::string package) {
+	PackageCache::Package info;
+	if (findPackage(package, info))
+		return info.libDir;
+
 	std::string cmd = std::format("pm list packages -3 -f | sed -n 's/^package:\\(.*\\)base\\.apk={}$/\\1/p'", package);
 	std::string str = this->ShellCommand(cmd) + "lib/";
 	return str;
@@ -243,44 +601,91 @@ bool ADB::PushFile(QFileInfo src, QString dst) {
 	QString filename = src.fileName();
 	dst = dst.endsWith('/') ? dst + filename : dst;
 	LOGD("Pushing %s", dst.toStdString().c_str());
-	if (!pushFileStreaming(serial.c_str(), src, dst)) {
+	if (!transferFile(src, dst)) {
 		LOGD("Unable to push directly. Try pushing to Download folder");
 		QString staging = "/sdcard/Download/" + filename;
-		if (!pushFileStreaming(serial.c_str(), src, staging)) {
+		if (!transferFile(src, staging)) {
 			LOGD("Failed to push to Download folder");
 			return false;
 		}
-		this->ShellCommandPrivileged(QString("mv /sdcard/Download/%1 %2").arg(filename, dst));
+		this->ShellCommandPrivileged(QString("mv %1 %2").arg(AdbShell::Quote(staging), AdbShell::Quote(dst)));
 	}
-	this->ShellCommandPrivileged(QString("chmod 777 %1").arg(dst));
+	this->ShellCommandPrivileged(QString("chmod 777 %1").arg(AdbShell::Quote(dst)));
 	return this->GetRemoteSize(dst);
 }
 
-bool ADB::InstallReplayApk() {
-	QFileInfo localReplayApkPath(QDir(QCoreApplication::applicationDirPath()), "tools/replay-debug.apk");
+bool ADB::PullFile(QString src, QFileInfo dst) {
+	if (dst.isDir())
+		dst = QFileInfo(QDir(dst.absoluteFilePath()), QFileInfo(src).fileName());
+	LOGD("Pulling %s", src.toStdString().c_str());
 
-	std::string cmd = "pm list packages -3 | grep com.lunarg.gfxreconstruct.replay";
-	if (this->ShellCommand(cmd).length()) {
-		LOGD("Replay APK already installed");
-		return true;
+	// A sync pull starts over, so it only stands in when resuming is
+	// impossible, never after a resumable pull stopped part way
+	PullResult result = pullFileResumable(src, dst);
+	if (result == PullResult::Failed) {
+		LOGD("Pull of %s stopped, the next pull resumes it", src.toStdString().c_str());
+		return false;
 	}
+	if (result == PullResult::Unsupported && !pullFileSync(src, dst)) {
+		LOGD("Unable to pull directly. Try staging in Download folder");
+		QString staging = "/sdcard/Download/" + QFileInfo(src).fileName();
+		this->ShellCommandPrivileged(QString("cp %1 %2 && chmod 666 %2").arg(AdbShell::Quote(src), AdbShell::Quote(staging)));
+		if (pullFileResumable(staging, dst) != PullResult::Done) {
+			LOGD("Failed to pull from Download folder");
+			return false;
+		}
+		this->ShellCommand(QString("rm %1").arg(AdbShell::Quote(staging)));
+	}
+	return QFileInfo::exists(dst.absoluteFilePath());
+}
+
+bool ADB::InstallReplayApk() {
+	QFileInfo localReplayApkPath = LocalReplayApk();
+	std::shared_future<QString> localHash = DeployManifest::LocalHash(localReplayApkPath.absoluteFilePath());
+
+	// Changes whenever the package is installed or updated, by us or anyone else
+	QString cmd = QString("dumpsys package %1 | grep -m 1 lastUpdateTime").arg(REPLAY_PACKAGE);
+	QString stamp = this->ShellCommand(cmd);
+	const bool installed = stamp.contains("lastUpdateTime");
 
-	LOGD("Installing replay APK");
 	if (!localReplayApkPath.isFile()) {
+		if (installed) {
+			LOGD("No local replay APK, using the installed one");
+			return true;
+		}
 		LOGW("Failed to find replay APK at %s", localReplayApkPath.absoluteFilePath().toStdString().c_str());
 		return false;
 	}
 
+	DeployManifest::Entry entry;
+	if (installed && manifest && manifest->Find("replay-apk", entry) && entry.hash == localHash.get() && entry.stamp == stamp) {
+		LOGD("Replay APK already installed");
+		return true;
+	}
+
+	// A failed attempt may leave the old install half replaced, so it is
+	// forgotten and the next attempt deploys again
+	LOGD("Installing replay APK");
 	if (!this->PushFile(localReplayApkPath, "/sdcard/Download/gfxr_replay.apk")) {
 		LOGW("Failed to push replay APK to /sdcard/Download/");
+		if (manifest)
+			manifest->Remove("replay-apk");
 		return false;
 	}
 
 	std::string result = this->ShellCommand("pm install -g -t -r /sdcard/Download/gfxr_replay.apk");
 	if (result.find("success") == std::string::npos && result.find("Success") == std::string::npos) {
 		LOGW("Failed to install replay APK");
+		if (manifest)
+			manifest->Remove("replay-apk");
 		return false;
 	}
+	PackageCache::getInstance().Invalidate(serial);
+	// run-as may work now that the replay APK is installed
+	profileValid = false;
+
+	if (manifest)
+		manifest->Put("replay-apk", { localHash.get(), "", localReplayApkPath.size(), this->ShellCommand(cmd) });
 
 	return true;
 }
@@ -310,38 +715,277 @@ bool ADB::PushRecordLayer(std::string package) {
 	}
 	LOGD("ABI of %s is %s arch %s", package.c_str(), abi.c_str(), arch.c_str());
 
-	QFileInfo localRecordLayerPath(QDir(QCoreApplication::applicationDirPath()), QString("layer/%1/libVkLayer_gfxreconstruct.so").arg(abi.c_str()));
+	QFileInfo localRecordLayerPath = LocalRecordLayer(abi);
 	if (!localRecordLayerPath.isFile()) {
 		LOGW("Failed to find debug layer at %s", localRecordLayerPath.absoluteFilePath().toStdString().c_str());
 		return false;
 	}
+	std::shared_future<QString> localHash = DeployManifest::LocalHash(localRecordLayerPath.absoluteFilePath());
 
 	QString dstPath = QString("%1%2/").arg(this->GetAppLibDir(package).c_str(), arch.c_str());
+	QString dstFile = dstPath + localRecordLayerPath.fileName();
+	QString key = QString("layer/%1/%2").arg(package.c_str(), abi.c_str());
+
+	// App updates move or wipe the lib dir, so the size on device is checked too
+	DeployManifest::Entry entry;
+	if (manifest && manifest->Find(key, entry) && entry.hash == localHash.get() && entry.path == dstFile &&
+		this->GetRemoteSize(dstFile) == localRecordLayerPath.size()) {
+		LOGD("Layer already deployed to %s", dstFile.toStdString().c_str());
+		return true;
+	}
+
 	if (!this->PushFile(localRecordLayerPath, dstPath)) {
 		LOGW("Failed to push layer to app lib path %s", dstPath.toStdString().c_str());
+		if (manifest)
+			manifest->Remove(key);
+		return false;
+	}
+
+	if (manifest)
+		manifest->Put(key, { localHash.get(), dstFile, localRecordLayerPath.size(), "" });
+
+	return true;
+}
+
+bool ADB::SyncFile(QFileInfo local, QString remote) {
+	const qint64 localSize = local.size();
+	const qint64 remoteSize = this->GetRemoteSize(remote);
+
+	QFile f(local.absoluteFilePath());
+	if (!f.open(QIODevice::ReadOnly))
+		return false;
+
+	std::vector<Chunker::Chunk> chunks;
+	if (!Chunker::Split(f, chunks))
+		return false;
+
+	std::vector<Chunker::Chunk> present;
+	if (remoteSize > 0 && !findRemoteChunks(remote, remoteSize, chunks, present))
+		LOGD("Unable to compare chunks of %s", remote.toStdString().c_str());
+
+	// Chunks are matched by hash, so content a trim or insert moved is
+	// still copied from where it now sits on the device
+	std::map<QByteArray, qint64> found;
+	for (const Chunker::Chunk& chunk : present)
+		found.emplace(chunk.hash, chunk.offset);
+
+	std::vector<Splice> copies;
+	std::vector<Chunker::Chunk> dirty;
+	qint64 dirtySize = 0;
+	for (const Chunker::Chunk& chunk : chunks) {
+		auto it = found.find(chunk.hash);
+		if (it == found.end()) {
+			dirty.push_back(chunk);
+			dirtySize += chunk.length;
+			continue;
+		}
+		Splice* last = copies.empty() ? nullptr : &copies.back();
+		if (last && last->from + last->length == it->second && last->to + last->length == chunk.offset)
+			last->length += chunk.length;
+		else
+			copies.push_back({ it->second, chunk.offset, chunk.length });
+	}
+
+	LOGD("%zu chunks (%lld bytes) of %s to send, %zu ranges reused", dirty.size(), dirtySize, remote.toStdString().c_str(), copies.size());
+
+	const bool inPlace = std::all_of(copies.begin(), copies.end(), [](const Splice& copy) { return copy.from == copy.to; });
+	bool result = dirty.empty() && inPlace && localSize == remoteSize;
+	if (!result && dirtySize <= localSize / 2)
+		result = patchChunks(f, remote, copies, dirty) && this->GetRemoteSize(remote) == localSize;
+	if (!result) {
+		LOGD("Delta upload not worthwhile or failed, pushing whole file");
+		result = this->PushFile(local, remote);
+	}
+
+	if (manifest) {
+		if (result)
+			manifest->PutChunks(remote, chunks);
+		else
+			manifest->RemoveChunks(remote);
+	}
+	return result;
+}
+
+// Finds the chunks the remote file still holds. The record of the last sync
+// gives the remote boundaries; without one the local boundaries are tried
+// at the same offsets, which still finds whatever an in-place edit left.
+// Either way the device hashes each range, so a stale record costs only
+// the chunks that no longer match.
+bool ADB::findRemoteChunks(QString remote, qint64 remoteSize, const std::vector<Chunker::Chunk>& local, std::vector<Chunker::Chunk>& present) {
+	const DeviceProfile& profile = this->GetProfile();
+	if (!profile.HasApplet("dd") || !profile.HasApplet("sha1sum"))
 		return false;
+
+	std::vector<Chunker::Chunk> candidates;
+	if (!manifest || !manifest->FindChunks(remote, candidates) || candidates.back().offset + candidates.back().length != remoteSize) {
+		candidates.clear();
+		for (const Chunker::Chunk& chunk : local) {
+			if (chunk.offset + chunk.length <= remoteSize)
+				candidates.push_back(chunk);
+		}
 	}
 
+	// A batch of ranges per round trip
+	const size_t BATCH = 256;
+	present.clear();
+	for (size_t begin = 0; begin < candidates.size(); begin += BATCH) {
+		const size_t end = std::min(candidates.size(), begin + BATCH);
+		QString cmd = QString("f=%1; for r in").arg(AdbShell::Quote(remote));
+		for (size_t i = begin; i < end; i++)
+			cmd += QString(" %1:%2").arg(candidates[i].offset).arg(candidates[i].length);
+		cmd += "; do dd if="$f" bs=1048576 iflag=skip_bytes,count_bytes skip=${r%:*} count=${r#*:} 2>/dev/null | sha1sum; done";
+
+		const QStringList lines = this->ShellCommandPrivileged(cmd).split('\n');
+		if (static_cast<size_t>(lines.size()) != end - begin)
+			return false;
+
+		for (size_t i = begin; i < end; i++) {
+			const QByteArray remoteHash = lines[i - begin].section(' ', 0, 0).trimmed().toUtf8();
+			if (remoteHash == candidates[i].hash)
+				present.push_back(candidates[i]);
+		}
+	}
 	return true;
 }
 
-bool ADB::AlreadyUploaded(QFileInfo local, QString remote) {
-	qint64 localSize = local.size();
-	size_t remoteSize = this->GetRemoteSize(remote);
+// Builds the new file on the device from ranges of the old one and a delta
+// of the chunks the device lacks, pushed through sync. When every reused
+// range stays where it is the old file is patched in place; otherwise the
+// new one is assembled next to it and moved over, so no range is read after
+// it has been overwritten.
+bool ADB::patchChunks(QFile& local, QString remote, const std::vector<Splice>& copies, const std::vector<Chunker::Chunk>& dirty) {
+	const bool inPlace = std::all_of(copies.begin(), copies.end(), [](const Splice& copy) { return copy.from == copy.to; });
+	const QString target = inPlace ? remote : remote + ".sync";
+
+	QTemporaryFile delta(QDir::temp().filePath("gfxr-XXXXXX.delta"));
+	if (!delta.open())
+		return false;
+
+	std::vector<Splice> ranges;
+	QByteArray buf;
+	for (const Chunker::Chunk& chunk : dirty) {
+		if (!local.seek(chunk.offset))
+			return false;
+		buf = local.read(chunk.length);
+		if (buf.size() != chunk.length || delta.write(buf) != buf.size())
+			return false;
+		ranges.push_back({ delta.pos() - chunk.length, chunk.offset, chunk.length });
+	}
+	delta.flush();
+
+	const DeviceProfile& profile = this->GetProfile();
+	if (profile.sdcardFree >= 0 && profile.sdcardFree < delta.size()) {
+		LOGD("Not enough space on /sdcard to stage the delta");
+		return false;
+	}
 
-	LOGD("local size %zd remote size %zu", localSize, remoteSize);
+	if (!inPlace) {
+		this->ShellCommandPrivileged(QString("rm -f %1").arg(AdbShell::Quote(target)));
+		if (!spliceRanges(remote, target, copies)) {
+			this->ShellCommandPrivileged(QString("rm -f %1").arg(AdbShell::Quote(target)));
+			return false;
+		}
+	}
 
-	return localSize == remoteSize;
+	bool result = true;
+	if (!ranges.empty()) {
+		QString staging = QString("/sdcard/Download/%1.delta").arg(QFileInfo(remote).fileName());
+		result = transferFile(QFileInfo(delta.fileName()), staging) && spliceRanges(staging, target, ranges);
+		this->ShellCommand(QString("rm %1").arg(AdbShell::Quote(staging)));
+	}
+
+	if (result)
+		this->ShellCommandPrivileged(QString("truncate -s %1 %2").arg(local.size()).arg(AdbShell::Quote(target)));
+	if (!inPlace) {
+		if (result)
+			result = this->ShellCommandPrivileged(QString("mv %1 %2 && echo Moved").arg(AdbShell::Quote(target), AdbShell::Quote(remote))).contains("Moved");
+		if (!result)
+			this->ShellCommandPrivileged(QString("rm -f %1").arg(AdbShell::Quote(target)));
+	}
+	return result;
+}
+
+// Copies byte ranges between two device files with seeking writes, a batch
+// of ranges per round trip
+bool ADB::spliceRanges(QString from, QString to, const std::vector<Splice>& ranges) {
+	const size_t BATCH = 256;
+	for (size_t begin = 0; begin < ranges.size(); begin += BATCH) {
+		const size_t end = std::min(ranges.size(), begin + BATCH);
+		QString cmd = QString("f=%1; d=%2; for r in").arg(AdbShell::Quote(to), AdbShell::Quote(from));
+		for (size_t i = begin; i < end; i++)
+			cmd += QString(" %1:%2:%3").arg(ranges[i].from).arg(ranges[i].to).arg(ranges[i].length);
+		cmd += "; do s=${r%%:*}; r=${r#*:}; "
+			"dd if=\"$d\" of=\"$f\" bs=1048576 iflag=skip_bytes,count_bytes oflag=seek_bytes conv=notrunc "
+			"skip=$s seek=${r%:*} count=${r#*:} 2>/dev/null || echo PatchFailed; done";
+		if (this->ShellCommandPrivileged(cmd).contains("PatchFailed"))
+			return false;
+	}
+	return true;
 }
 
 void ADB::SetRecordProp(std::string package) {
 	this->ShellCommand("settings put global enable_gpu_debug_layers 1");
 	this->ShellCommand(std::format("settings put global gpu_debug_app {}", package));
 	this->ShellCommand("settings put global gpu_debug_layers VK_LAYER_LUNARG_gfxreconstruct");
-	this->ShellCommand(std::format("setprop debug.gfxrecon.capture_file /sdcard/Download/{}.gfxr", package));
+	this->ShellCommand(QString("setprop debug.gfxrecon.capture_file %1").arg(GetCaptureFile(package)));
+	// Keep the file name predictable so it can be followed and pulled
+	this->ShellCommand("setprop debug.gfxrecon.capture_file_timestamp false");
+	this->ShellCommand(QString("rm -f %1").arg(GetCaptureFile(package)));
+}
+
+QString ADB::GetCaptureFile(std::string package) {
+	return QString("/sdcard/Download/%1.gfxr").arg(package.c_str());
+}
+
+std::unique_ptr<CaptureFollower> ADB::FollowCapture(std::string package, QString local) {
+	auto follower = std::make_unique<CaptureFollower>(serial, GetCaptureFile(package), local);
+	if (!follower->IsOpen()) {
+		LOGW("Failed to open %s to follow the capture: %s", local.toStdString().c_str(), follower->GetError().toStdString().c_str());
+		return nullptr;
+	}
+	return follower;
+}
+
+void ADB::SetCompression(bool enable) {
+	compression = enable;
+}
+
+void ADB::SetProgressHandler(ProgressHandler handler) {
+	progressHandler = handler;
+}
+
+QString ADB::GetReplayFile(QString fileName) {
+	return "/data/user/0/com.lunarg.gfxreconstruct.replay/files/" + fileName;
+}
+
+QString ADB::GetDeviceTime() {
+	// logcat -T takes epoch seconds, with milliseconds where date has %N
+	static const QRegularExpression pattern("^(\\d+)(\\.\\d{1,3})?");
+	QRegularExpressionMatch match = pattern.match(this->ShellCommand(QString("date +%s.%N")).trimmed());
+	return match.hasMatch() ? match.captured(0) : QString();
+}
+
+bool ADB::LaunchReplay(QString remote, QString args) {
+	this->ShellCommand("am force-stop com.lunarg.gfxreconstruct.replay");
+
+	QString cmd = QString(
+		"am start -n \"com.lunarg.gfxreconstruct.replay/android.app.NativeActivity\""
+		" -a android.intent.action.MAIN -c android.intent.category.LAUNCHER"
+		" --es \"args\" \"%1%2\"").arg(args, remote);
+	QString result = this->ShellCommand(cmd);
+	if (result.contains("Error")) {
+		LOGD("Failed to launch replay: %s", result.toStdString().c_str());
+		return false;
+	}
+	return true;
 }
 
 qint64 ADB::GetRemoteSize(QString remotePath) {
-	QString strRemoteSize = this->ShellCommandPrivileged(QString("stat -c%s %1").arg(remotePath));
+	AdbSync::RemoteStat stat;
+	if (AdbSync(serial).Stat(remotePath, stat) && stat.exists)
+		return stat.size;
+
+	// Files in app private directories are invisible to the sync service
+	QString strRemoteSize = this->ShellCommandPrivileged(QString("stat -c%s %1").arg(AdbShell::Quote(remotePath)));
 	return strRemoteSize.toLongLong();
 }
\ No newline at end of file
@@ -26,38 +26,101 @@
 
 #include <QString>
 #include <QFileInfo>
+#include <QFile>
 
 #include <vector>
 #include <string>
 #include <filesystem>
+#include <memory>
+#include <functional>
+
+#include "adbclient.hpp"
+#include "chunker.hpp"
+#include "packagecache.hpp"
+#include "deviceprofile.hpp"
+#include "deploymanifest.hpp"
+
+class AdbShell;
+class CaptureFollower;
 
 class ADB {
 public:
+    // Returns false to cancel the transfer in progress
+    using ProgressHandler = std::function<bool(QString text, int percent)>;
+
+    static constexpr const char* REPLAY_PACKAGE = "com.lunarg.gfxreconstruct.replay";
+
     ADB();
     ~ADB();
     std::vector<std::string> GetDevices();
     bool ConnectDevice(std::string serial);
+    void Disconnect();
+    std::string GetSerial() const;
     QString ShellCommand(QString cmd);
     std::string ShellCommand(std::string cmd);
     std::string ShellCommand(const char* cmd);
     QString ShellCommandPrivileged(QString cmd);
     std::string ShellCommandPrivileged(std::string cmd);
     std::string ShellCommandPrivileged(const char* cmd);
+    const DeviceProfile& GetProfile();
     std::vector<std::string> GetPackages();
+    void GetPackages(std::function<bool(const std::string&)> callback);
     std::string GetCurrentApp();
+    std::string GetLauncherActivity(std::string package);
     bool PushFile(QFileInfo src, QString dst);
+    bool PullFile(QString src, QFileInfo dst);
     bool InstallReplayApk();
     bool PushRecordLayer(std::string package);
-    bool AlreadyUploaded(QFileInfo local, QString remote);
+    bool SyncFile(QFileInfo local, QString remote);
     void SetRecordProp(std::string package);
+    std::unique_ptr<CaptureFollower> FollowCapture(std::string package, QString local);
+    void SetCompression(bool enable);
+    void SetProgressHandler(ProgressHandler handler);
+    QString GetDeviceTime();
+    bool LaunchReplay(QString remote, QString args);
+    static QString GetReplayFile(QString fileName);
+    static void SetupEnvironment();
 
 private:
+    enum class PullResult {
+        Done,
+        Unsupported,
+        Failed,
+    };
+
+    // Bytes [from, from + length) of one file go to [to, to + length) of another
+    struct Splice {
+        qint64 from;
+        qint64 to;
+        qint64 length;
+    };
+
     QString runProgram(const QString& program, const QStringList& args);
-    bool pushFileStreaming(std::string serial, QFileInfo src, QString dst);
+    bool shellCommand(const QString& cmd, QString& output);
+    bool transferFile(QFileInfo src, QString dst);
+    bool pushFileSync(QFileInfo src, QString dst);
+    bool pushFileCompressed(QFileInfo src, QString dst);
+    bool pullFileSync(QString src, QFileInfo dst);
+    PullResult pullFileResumable(QString src, QFileInfo dst);
+    qint64 verifiedOffset(QFile& part, QString src);
     qint64 GetRemoteSize(QString remotePath);
+    bool findRemoteChunks(QString remote, qint64 remoteSize, const std::vector<Chunker::Chunk>& local, std::vector<Chunker::Chunk>& present);
+    bool patchChunks(QFile& local, QString remote, const std::vector<Splice>& copies, const std::vector<Chunker::Chunk>& dirty);
+    bool spliceRanges(QString from, QString to, const std::vector<Splice>& ranges);
+    bool loadPackages(std::vector<PackageCache::Package>& packages);
+    bool findPackage(const std::string& package, PackageCache::Package& info);
     std::string GetAppAbi(std::string package);
     std::string GetAppLibDir(std::string package);
+    QString GetCaptureFile(std::string package);
 
 private:
     std::string serial;
+    std::unique_ptr<AdbShell> shell;
+    AdbClient client;
+    bool compression;
+    double syncThroughput;
+    ProgressHandler progressHandler;
+    DeviceProfile profile;
+    bool profileValid;
+    std::unique_ptr<DeployManifest> manifest;
 };
\ No newline at end of file
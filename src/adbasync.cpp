@@ -0,0 +1,70 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "adbasync.hpp"
+
+#include "common.hpp"
+
+AdbAsync::AdbAsync(ADB& adb, QObject* parent)
+	: QObject(parent), adb(adb)
+{
+	pool.setMaxThreadCount(1);
+	pool.setExpiryTimeout(-1);
+
+	// Emitted on the worker, delivered queued to receivers on the GUI thread
+	adb.SetProgressHandler([this](QString text, int percent) {
+		emit TransferProgress(text, percent);
+		return true;
+	});
+}
+
+AdbAsync::~AdbAsync() {
+	pool.clear();
+	Run([](ADB& adb) { adb.Disconnect(); }).waitForFinished();
+	pool.waitForDone();
+	adb.SetProgressHandler(nullptr);
+}
+
+QFuture<std::string> AdbAsync::GetDevices() {
+	return QtConcurrent::run(&pool, [this](QPromise<std::string>& promise) {
+		std::vector<std::string> devices = adb.GetDevices();
+		LOGD("ADB device num %zu", devices.size());
+		for (const std::string& device : devices) {
+			if (promise.isCanceled())
+				return;
+			LOGD("    %s", device.c_str());
+			promise.addResult(device);
+		}
+	});
+}
+
+QFuture<std::string> AdbAsync::GetPackages() {
+	return QtConcurrent::run(&pool, [this](QPromise<std::string>& promise) {
+		adb.GetPackages([&promise](const std::string& package) {
+			LOGD("    %s", package.c_str());
+			promise.addResult(package);
+			return !promise.isCanceled();
+		});
+	});
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
+
+#include <string>
+
+#include "adb.hpp"
+
+// Runs operations on an ADB instance off the GUI thread. The pool has a
+// single thread that never expires, so the device connections ADB keeps
+// are always used from the thread that opened them. List results stream
+// into the returned future as they are found and stop when it is canceled.
+class AdbAsync : public QObject {
+    Q_OBJECT
+
+public:
+    AdbAsync(ADB& adb, QObject* parent = nullptr);
+    ~AdbAsync();
+    QFuture<std::string> GetDevices();
+    QFuture<std::string> GetPackages();
+
+    template<typename Function>
+    auto Run(Function function) {
+        return QtConcurrent::run(&pool, [this, function]() {
+            return function(adb);
+        });
+    }
+
+signals:
+    void TransferProgress(QString text, int percent);
+
+private:
+    ADB& adb;
+    QThreadPool pool;
+};
\ No newline at end of file
@@ -0,0 +1,284 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "adbclient.hpp"
+
+#include <QTcpSocket>
+#include <QtEndian>
+#include <QStringList>
+
+#include <sstream>
+#include <cstring>
+#include <algorithm>
+#include "common.hpp"
+
+static const int SERVER_TIMEOUT_MS = 2000;
+
+// Largest payload older adbd accepts in one shell protocol packet
+static const qsizetype SHELL_PACKET_MAX = 4096 - 5;
+
+AdbClient::AdbClient()
+	: host("127.0.0.1"), port(5037)
+{
+	// Same overrides as the adb binary itself, e.g. ADB_SERVER_SOCKET=tcp:localhost:5038
+	const QString socketSpec = qEnvironmentVariable("ADB_SERVER_SOCKET");
+	if (socketSpec.startsWith("tcp:")) {
+		const QStringList parts = socketSpec.mid(4).split(':');
+		if (parts.size() == 2) {
+			host = parts[0];
+			port = parts[1].toUShort();
+		}
+		else if (parts.size() == 1) {
+			port = parts[0].toUShort();
+		}
+	}
+	else if (qEnvironmentVariableIsSet("ANDROID_ADB_SERVER_PORT")) {
+		port = qEnvironmentVariable("ANDROID_ADB_SERVER_PORT").toUShort();
+	}
+}
+
+AdbClient::AdbClient(QString host, quint16 port)
+	: host(host), port(port)
+{
+}
+
+AdbClient::~AdbClient() {
+}
+
+bool AdbClient::ReadExact(QTcpSocket& socket, char* data, qint64 size, int timeout) {
+	qint64 received = 0;
+	while (received < size) {
+		if (socket.bytesAvailable() == 0 && !socket.waitForReadyRead(timeout))
+			return false;
+		const qint64 n = socket.read(data + received, size - received);
+		if (n < 0)
+			return false;
+		received += n;
+	}
+	return true;
+}
+
+bool AdbClient::ReadShellPacket(QTcpSocket& socket, char& id, QByteArray& data) {
+	char header[5];
+	if (!ReadExact(socket, header, sizeof(header)))
+		return false;
+
+	id = header[0];
+	const quint32 length = qFromLittleEndian<quint32>(header + 1);
+	data.resize(length);
+	return ReadExact(socket, data.data(), length);
+}
+
+bool AdbClient::WriteShellPacket(QTcpSocket& socket, char id, const QByteArray& data) {
+	QByteArray packets;
+	packets.reserve(data.size() + (data.size() / SHELL_PACKET_MAX + 1) * 5);
+	qsizetype off = 0;
+	do {
+		const qsizetype length = std::min(SHELL_PACKET_MAX, data.size() - off);
+		char header[5];
+		header[0] = id;
+		qToLittleEndian<quint32>(length, header + 1);
+		packets.append(header, sizeof(header));
+		packets.append(data.constData() + off, length);
+		off += length;
+	} while (off < data.size());
+
+	return socket.write(packets) == packets.size();
+}
+
+std::unique_ptr<QTcpSocket> AdbClient::openServer() {
+	auto socket = std::make_unique<QTcpSocket>();
+	socket->connectToHost(host, port);
+	if (!socket->waitForConnected(SERVER_TIMEOUT_MS))
+		return nullptr;
+	return socket;
+}
+
+QString AdbClient::GetHost() const {
+	return host;
+}
+
+quint16 AdbClient::GetPort() const {
+	return port;
+}
+
+QByteArray AdbClient::FormatRequest(const QByteArray& request) {
+	return QByteArray::number(request.size(), 16).rightJustified(4, '0') + request;
+}
+
+bool AdbClient::sendRequest(QTcpSocket& socket, const QByteArray& request) {
+	const QByteArray packet = FormatRequest(request);
+	if (socket.write(packet) != packet.size())
+		return false;
+	while (socket.bytesToWrite() > 0) {
+		if (!socket.waitForBytesWritten(SERVER_TIMEOUT_MS))
+			return false;
+	}
+	return true;
+}
+
+bool AdbClient::readLengthPrefixed(QTcpSocket& socket, QByteArray& payload) {
+	char hex[4];
+	if (!ReadExact(socket, hex, sizeof(hex)))
+		return false;
+
+	bool ok = false;
+	const int length = QByteArray(hex, sizeof(hex)).toInt(&ok, 16);
+	if (!ok)
+		return false;
+
+	payload.resize(length);
+	return ReadExact(socket, payload.data(), length);
+}
+
+bool AdbClient::readStatus(QTcpSocket& socket, const QByteArray& request) {
+	char status[4];
+	if (!ReadExact(socket, status, sizeof(status), SERVER_TIMEOUT_MS)) {
+		LOGD("No response from adb server for %s", request.constData());
+		return false;
+	}
+
+	if (memcmp(status, "OKAY", sizeof(status)) == 0)
+		return true;
+
+	QByteArray message;
+	if (memcmp(status, "FAIL", sizeof(status)) == 0)
+		readLengthPrefixed(socket, message);
+	LOGD("adb server rejected %s: %s", request.constData(), message.constData());
+	return false;
+}
+
+std::unique_ptr<QTcpSocket> AdbClient::hostQuery(const QByteArray& request) {
+	auto socket = openServer();
+	if (!socket)
+		return nullptr;
+	if (!sendRequest(*socket, request) || !readStatus(*socket, request))
+		return nullptr;
+	return socket;
+}
+
+bool AdbClient::IsAvailable() {
+	auto socket = hostQuery("host:version");
+	QByteArray version;
+	return socket && readLengthPrefixed(*socket, version);
+}
+
+std::vector<AdbClient::Device> AdbClient::ParseDevices(const QByteArray& payload) {
+	std::vector<Device> devices;
+	std::istringstream iss(payload.toStdString());
+	std::string line;
+	while (std::getline(iss, line, '\n')) {
+		std::istringstream fields(line);
+		Device device;
+		if (!(fields >> device.serial >> device.state))
+			continue;
+
+		// "no permissions (...)" spans several words, skip to the key:value pairs
+		std::string field;
+		while (fields >> field) {
+			const size_t pos = field.find(':');
+			if (pos == std::string::npos)
+				continue;
+			const std::string key = field.substr(0, pos);
+			const std::string value = field.substr(pos + 1);
+			if (key == "product")
+				device.product = value;
+			else if (key == "model")
+				device.model = value;
+			else if (key == "device")
+				device.device = value;
+			else if (key == "transport_id")
+				device.transportId = value;
+		}
+		devices.push_back(device);
+	}
+	return devices;
+}
+
+bool AdbClient::ListDevices(std::vector<Device>& devices) {
+	auto socket = hostQuery("host:devices-l");
+	QByteArray payload;
+	if (!socket || !readLengthPrefixed(*socket, payload))
+		return false;
+
+	devices = ParseDevices(payload);
+	return true;
+}
+
+bool AdbClient::Connect(std::string address, QString& message) {
+	auto socket = hostQuery("host:connect:" + QByteArray::fromStdString(address));
+	QByteArray payload;
+	if (!socket || !readLengthPrefixed(*socket, payload))
+		return false;
+
+	message = QString::fromUtf8(payload).trimmed();
+	return message.startsWith("connected to") || message.startsWith("already connected to");
+}
+
+std::unique_ptr<QTcpSocket> AdbClient::OpenService(std::string serial, QString service) {
+	auto socket = hostQuery("host:transport:" + QByteArray::fromStdString(serial));
+	if (!socket)
+		return nullptr;
+
+	const QByteArray request = service.toUtf8();
+	if (!sendRequest(*socket, request) || !readStatus(*socket, request))
+		return nullptr;
+	return socket;
+}
+
+bool AdbClient::Shell(std::string serial, QString cmd, ShellResult& result) {
+	auto socket = OpenService(serial, "shell,v2,raw:" + cmd);
+	if (!socket) {
+		// Devices without shell protocol v2 only give a merged stream and no exit code
+		socket = OpenService(serial, "shell:" + cmd);
+		if (!socket)
+			return false;
+		result.started = true;
+		while (socket->bytesAvailable() > 0 || socket->waitForReadyRead(-1))
+			result.out += socket->readAll();
+		return true;
+	}
+
+	result.started = true;
+	while (true) {
+		char id;
+		QByteArray data;
+		if (!ReadShellPacket(*socket, id, data))
+			return false;
+
+		switch (id) {
+		case ShellStdout:
+			result.out += data;
+			break;
+		case ShellStderr:
+			result.err += data;
+			break;
+		case ShellExit:
+			result.exitCode = data.isEmpty() ? -1 : static_cast<unsigned char>(data[0]);
+			return true;
+		default:
+			break;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+
+#include <vector>
+#include <string>
+#include <memory>
+
+class QTcpSocket;
+
+// Minimal client for the adb server's smart-socket protocol. Every request is
+// a fresh TCP connection to the server (localhost:5037 unless overridden by
+// ADB_SERVER_SOCKET or ANDROID_ADB_SERVER_PORT), so the client is usable from
+// any thread and against any stand-in server that speaks the same framing.
+class AdbClient {
+public:
+    enum ShellPacketId : char {
+        ShellStdin = 0,
+        ShellStdout = 1,
+        ShellStderr = 2,
+        ShellExit = 3,
+        ShellCloseStdin = 4,
+    };
+
+    struct Device {
+        std::string serial;
+        std::string state;
+        std::string product;
+        std::string model;
+        std::string device;
+        std::string transportId;
+    };
+
+    struct ShellResult {
+        QByteArray out;
+        QByteArray err;
+        int exitCode = -1;
+        // Set once the service opened, so the command may have run even if
+        // Shell then fails
+        bool started = false;
+    };
+
+    AdbClient();
+    AdbClient(QString host, quint16 port);
+    ~AdbClient();
+    bool IsAvailable();
+    bool ListDevices(std::vector<Device>& devices);
+    bool Connect(std::string address, QString& message);
+    bool Shell(std::string serial, QString cmd, ShellResult& result);
+    std::unique_ptr<QTcpSocket> OpenService(std::string serial, QString service);
+    QString GetHost() const;
+    quint16 GetPort() const;
+
+    static QByteArray FormatRequest(const QByteArray& request);
+    static std::vector<Device> ParseDevices(const QByteArray& payload);
+    static bool ReadExact(QTcpSocket& socket, char* data, qint64 size, int timeout = -1);
+    static bool ReadShellPacket(QTcpSocket& socket, char& id, QByteArray& data);
+    static bool WriteShellPacket(QTcpSocket& socket, char id, const QByteArray& data);
+
+private:
+    std::unique_ptr<QTcpSocket> openServer();
+    bool sendRequest(QTcpSocket& socket, const QByteArray& request);
+    bool readStatus(QTcpSocket& socket, const QByteArray& request);
+    bool readLengthPrefixed(QTcpSocket& socket, QByteArray& payload);
+    std::unique_ptr<QTcpSocket> hostQuery(const QByteArray& request);
+
+private:
+    QString host;
+    quint16 port;
+};
\ No newline at end of file
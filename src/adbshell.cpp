@@ -0,0 +1,175 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "adbshell.hpp"
+
+#include <QProcess>
+#include <QTcpSocket>
+#include <QRandomGenerator>
+
+#include "adbclient.hpp"
+#include "common.hpp"
+
+AdbShell::AdbShell(std::string serial)
+	: serial(serial), sequence(0)
+{
+	marker = QString("__GFXR_%1_").arg(QRandomGenerator::global()->generate64(), 16, 16, QChar('0')).toUtf8();
+}
+
+AdbShell::~AdbShell() {
+	Close();
+}
+
+QString AdbShell::Quote(const QString& arg) {
+	QString quoted = arg;
+	quoted.replace("'", "'\\''");
+	return "'" + quoted + "'";
+}
+
+bool AdbShell::IsAlive() const {
+	if (auto* process = qobject_cast<QProcess*>(stream.get()))
+		return process->state() == QProcess::Running;
+	if (auto* socket = qobject_cast<QTcpSocket*>(stream.get()))
+		return socket->state() == QAbstractSocket::ConnectedState;
+	return false;
+}
+
+void AdbShell::Close() {
+	if (!stream)
+		return;
+
+	if (IsAlive())
+		stream->write("exit\n");
+
+	if (auto* process = qobject_cast<QProcess*>(stream.get())) {
+		process->closeWriteChannel();
+		if (!process->waitForFinished(1000)) {
+			process->kill();
+			process->waitForFinished(1000);
+		}
+	}
+	else if (auto* socket = qobject_cast<QTcpSocket*>(stream.get())) {
+		socket->waitForBytesWritten(1000);
+		socket->disconnectFromHost();
+	}
+
+	stream.reset();
+	pending.clear();
+}
+
+bool AdbShell::start() {
+	Close();
+
+	stream = AdbClient().OpenService(serial, "shell,raw:sh");
+	if (stream) {
+		LOGD("Shell session started on %s over adb server", serial.c_str());
+		return true;
+	}
+
+	return startProcess();
+}
+
+bool AdbShell::startProcess() {
+	auto process = std::make_unique<QProcess>();
+	process->setProgram("adb");
+	process->setArguments({ "-s", serial.c_str(), "shell", "sh" });
+	process->setStandardErrorFile(QProcess::nullDevice());
+	process->start();
+
+	if (!process->waitForStarted()) {
+		LOGD("Failed to start shell session on %s", serial.c_str());
+		return false;
+	}
+
+	LOGD("Shell session started on %s over adb process", serial.c_str());
+	stream = std::move(process);
+	return true;
+}
+
+bool AdbShell::exec(const QString& cmd, QByteArray& output, int& exitCode, bool& sent) {
+	// Every command runs in its own "sh -c" with stdin detached so that a
+	// syntax error or a stdin reader cannot desynchronize the session.
+	const QByteArray tag = marker + QByteArray::number(++sequence);
+	const QByteArray script = "sh -c " + Quote(cmd).toUtf8() + " </dev/null; printf '\\n" + tag + " %d\\n' $?\n";
+
+	sent = false;
+	if (stream->write(script) != script.size())
+		return false;
+	sent = true;
+
+	const QByteArray needle = "\n" + tag + " ";
+	while (true) {
+		const qsizetype pos = pending.indexOf(needle);
+		if (pos >= 0) {
+			const qsizetype codePos = pos + needle.size();
+			const qsizetype end = pending.indexOf('\n', codePos);
+			if (end >= 0) {
+				output = pending.left(pos);
+				exitCode = pending.mid(codePos, end - codePos).toInt();
+				pending.remove(0, end + 1);
+				return true;
+			}
+		}
+
+		if (stream->bytesAvailable() == 0 && !stream->waitForReadyRead(-1))
+			return false;
+		pending += stream->readAll();
+	}
+}
+
+bool AdbShell::Run(const QString& cmd, QString& output, int* exitCode, bool* sent) {
+	QByteArray raw;
+	int code = -1;
+	bool written = false;
+
+	if (sent)
+		*sent = false;
+
+	for (int attempt = 0; attempt < 2; attempt++) {
+		if (!IsAlive() && !start())
+			return false;
+
+		if (exec(cmd, raw, code, written)) {
+			output = QString::fromUtf8(raw).trimmed();
+			if (exitCode)
+				*exitCode = code;
+			return true;
+		}
+
+		// Only a command that never went out is retried; one that did may
+		// already have run, which is reported through sent instead
+		if (written) {
+			LOGD("Shell session on %s died running a command", serial.c_str());
+			Close();
+			if (sent)
+				*sent = true;
+			return false;
+		}
+
+		LOGD("Shell session on %s died, reconnecting", serial.c_str());
+		Close();
+	}
+
+	return false;
+}
\ No newline at end of file
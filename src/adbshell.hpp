@@ -0,0 +1,63 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+
+#include <memory>
+#include <string>
+
+class QIODevice;
+
+// A long-lived shell bound to one device, opened as a "shell,raw:sh" stream on
+// the adb server or through an "adb shell sh" process when the server cannot
+// be reached directly. Commands are written to the shell's stdin and their
+// output is delimited by a per-session sentinel line carrying the exit code,
+// so each command costs a single round trip instead of spawning a new adb
+// process.
+class AdbShell {
+public:
+    AdbShell(std::string serial);
+    ~AdbShell();
+    bool Run(const QString& cmd, QString& output, int* exitCode = nullptr, bool* sent = nullptr);
+    bool IsAlive() const;
+    void Close();
+
+    // Single-quotes an argument for the device's sh
+    static QString Quote(const QString& arg);
+
+private:
+    bool start();
+    bool startProcess();
+    bool exec(const QString& cmd, QByteArray& output, int& exitCode, bool& sent);
+
+private:
+    std::string serial;
+    std::unique_ptr<QIODevice> stream;
+    QByteArray marker;
+    QByteArray pending;
+    quint64 sequence;
+};
\ No newline at end of file
@@ -0,0 +1,74 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "adbstream.hpp"
+
+#include <QTcpSocket>
+
+#include "adbclient.hpp"
+#include "adbshell.hpp"
+#include "common.hpp"
+
+static QString ddCommand(QString path, qint64 offset, qint64 length) {
+	QString cmd = QString("dd if=%1 bs=1048576 iflag=skip_bytes,count_bytes skip=%2").arg(AdbShell::Quote(path)).arg(offset);
+	if (length >= 0)
+		cmd += QString(" count=%1").arg(length);
+	return cmd + " 2>/dev/null";
+}
+
+AdbStream::AdbStream(std::string serial)
+	: serial(serial)
+{
+}
+
+AdbStream::~AdbStream() {
+}
+
+AdbStream::Result AdbStream::ReadRange(QString path, qint64 offset, qint64 length, Sink sink) {
+	auto socket = AdbClient().OpenService(serial, "shell,v2,raw:" + ddCommand(path, offset, length));
+	if (!socket)
+		return Result::Disconnected;
+
+	char id;
+	QByteArray data;
+	while (AdbClient::ReadShellPacket(*socket, id, data)) {
+		if (id == AdbClient::ShellStdout) {
+			if (!sink(data.constData(), data.size()))
+				return Result::Failed;
+		}
+		else if (id == AdbClient::ShellExit) {
+			return !data.isEmpty() && data[0] == 0 ? Result::Done : Result::Failed;
+		}
+	}
+
+	LOGD("Stream of %s from %s interrupted", path.toStdString().c_str(), serial.c_str());
+	return Result::Disconnected;
+}
+
+QByteArray AdbStream::HashRange(QString path, qint64 offset, qint64 length) {
+	AdbClient::ShellResult result;
+	if (!AdbClient().Shell(serial, ddCommand(path, offset, length) + " | sha1sum", result) || result.exitCode != 0)
+		return QByteArray();
+	return result.out.trimmed().split(' ').value(0);
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+
+#include <string>
+#include <functional>
+
+// Streams byte ranges of a remote file through "dd" over an adb shell v2
+// session. Unlike sync RECV a read can start at any offset, which is what
+// resuming an interrupted pull or following a growing file needs.
+class AdbStream {
+public:
+    using Sink = std::function<bool(const char* data, qint64 size)>;
+
+    // Disconnected is the only outcome worth retrying: the session ended
+    // before dd did. Failed covers dd errors and a sink that gave up.
+    enum class Result {
+        Done,
+        Failed,
+        Disconnected,
+    };
+
+    AdbStream(std::string serial);
+    ~AdbStream();
+    Result ReadRange(QString path, qint64 offset, qint64 length, Sink sink);
+    QByteArray HashRange(QString path, qint64 offset, qint64 length);
+
+private:
+    std::string serial;
+};
\ No newline at end of file
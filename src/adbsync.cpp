@@ -0,0 +1,250 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "adbsync.hpp"
+
+#include <QTcpSocket>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QtEndian>
+
+#include <cstring>
+#include <algorithm>
+#include "adbclient.hpp"
+#include "common.hpp"
+
+// Largest DATA payload adbd accepts per frame
+static const qint64 SYNC_DATA_MAX = 64 * 1024;
+// Bytes of DATA frames assembled per socket write
+static const qint64 SYNC_BATCH_SIZE = 1 << 20;
+// Unsent bytes allowed to queue up in the socket before waiting
+static const qint64 SYNC_WRITE_LIMIT = 8 << 20;
+
+AdbSync::AdbSync(std::string serial)
+	: serial(serial), statV2(true)
+{
+}
+
+AdbSync::~AdbSync() {
+	Close();
+}
+
+bool AdbSync::Open() {
+	if (socket && socket->state() == QAbstractSocket::ConnectedState)
+		return true;
+
+	socket = AdbClient().OpenService(serial, "sync:");
+	if (!socket) {
+		LOGD("Failed to open sync service on %s", serial.c_str());
+		return false;
+	}
+	return true;
+}
+
+void AdbSync::Close() {
+	if (!socket)
+		return;
+
+	if (socket->state() == QAbstractSocket::ConnectedState) {
+		sendRequest("QUIT", QByteArray());
+		socket->disconnectFromHost();
+	}
+	socket.reset();
+}
+
+bool AdbSync::sendRequest(const char* id, const QByteArray& data) {
+	char header[8];
+	memcpy(header, id, 4);
+	qToLittleEndian<quint32>(data.size(), header + 4);
+	if (socket->write(header, sizeof(header)) != sizeof(header))
+		return false;
+	if (!data.isEmpty() && socket->write(data) != data.size())
+		return false;
+	return flush(0);
+}
+
+bool AdbSync::flush(qint64 limit) {
+	while (socket->bytesToWrite() > limit) {
+		if (!socket->waitForBytesWritten(-1))
+			return false;
+	}
+	return true;
+}
+
+bool AdbSync::readHeader(QByteArray& id, quint32& length) {
+	char header[8];
+	if (!AdbClient::ReadExact(*socket, header, sizeof(header)))
+		return false;
+	id = QByteArray(header, 4);
+	length = qFromLittleEndian<quint32>(header + 4);
+	return true;
+}
+
+bool AdbSync::readFailure(quint32 length) {
+	QByteArray message(length, Qt::Uninitialized);
+	AdbClient::ReadExact(*socket, message.data(), length);
+	LOGD("Sync failed on %s: %s", serial.c_str(), message.constData());
+	return false;
+}
+
+bool AdbSync::Stat(QString path, RemoteStat& stat) {
+	if (!Open())
+		return false;
+
+	stat = RemoteStat();
+	const QByteArray request = path.toUtf8();
+
+	if (statV2) {
+		char reply[72];
+		if (sendRequest("STA2", request) && AdbClient::ReadExact(*socket, reply, sizeof(reply))
+			&& memcmp(reply, "STA2", 4) == 0) {
+			const quint32 error = qFromLittleEndian<quint32>(reply + 4);
+			stat.exists = error == 0;
+			stat.mode = qFromLittleEndian<quint32>(reply + 24);
+			stat.size = qFromLittleEndian<quint64>(reply + 40);
+			stat.mtime = qFromLittleEndian<qint64>(reply + 56);
+			return true;
+		}
+
+		// Devices without stat_v2 drop the connection on STA2, retry with STAT
+		LOGD("STA2 not supported on %s, falling back to STAT", serial.c_str());
+		statV2 = false;
+		socket.reset();
+		if (!Open())
+			return false;
+	}
+
+	char reply[16];
+	if (!sendRequest("STAT", request) || !AdbClient::ReadExact(*socket, reply, sizeof(reply))
+		|| memcmp(reply, "STAT", 4) != 0)
+		return false;
+
+	stat.mode = qFromLittleEndian<quint32>(reply + 4);
+	stat.size = qFromLittleEndian<quint32>(reply + 8);
+	stat.mtime = qFromLittleEndian<quint32>(reply + 12);
+	stat.exists = stat.mode != 0;
+	return true;
+}
+
+bool AdbSync::Push(QFile& src, QString dst, quint32 mode, Progress progress) {
+	if (!Open())
+		return false;
+
+	const qint64 totalSize = src.size();
+	const QByteArray target = QString("%1,%2").arg(dst).arg(mode).toUtf8();
+	if (!sendRequest("SEND", target))
+		return false;
+
+	QByteArray block;
+	block.resize(SYNC_BATCH_SIZE);
+	QByteArray frames;
+	frames.reserve(SYNC_BATCH_SIZE + (SYNC_BATCH_SIZE / SYNC_DATA_MAX + 1) * 8);
+	qint64 sent = 0;
+
+	while (true) {
+		const qint64 n = src.read(block.data(), block.size());
+		if (n < 0)
+			return false;
+		if (n == 0)
+			break;
+
+		frames.clear();
+		for (qint64 off = 0; off < n; off += SYNC_DATA_MAX) {
+			const qint64 len = std::min(SYNC_DATA_MAX, n - off);
+			char header[8];
+			memcpy(header, "DATA", 4);
+			qToLittleEndian<quint32>(len, header + 4);
+			frames.append(header, sizeof(header));
+			frames.append(block.constData() + off, len);
+		}
+
+		if (socket->write(frames) != frames.size() || !flush(SYNC_WRITE_LIMIT))
+			return false;
+
+		// adbd answers FAIL early (e.g. permission denied) and stops reading
+		if (socket->bytesAvailable() >= 8) {
+			QByteArray id;
+			quint32 length;
+			readHeader(id, length);
+			return readFailure(length);
+		}
+
+		sent += n;
+		if (progress && !progress(sent, totalSize))
+			return false;
+	}
+
+	char done[8];
+	memcpy(done, "DONE", 4);
+	qToLittleEndian<quint32>(static_cast<quint32>(QFileInfo(src).lastModified().toSecsSinceEpoch()), done + 4);
+	if (socket->write(done, sizeof(done)) != sizeof(done) || !flush(0))
+		return false;
+
+	QByteArray id;
+	quint32 length;
+	if (!readHeader(id, length))
+		return false;
+	if (id != "OKAY")
+		return readFailure(length);
+
+	LOGD("Sync pushed %lld bytes to %s", sent, dst.toStdString().c_str());
+	return true;
+}
+
+bool AdbSync::Pull(QString src, QFile& dst, Progress progress) {
+	RemoteStat stat;
+	if (!Stat(src, stat) || !stat.exists)
+		return false;
+
+	if (!sendRequest("RECV", src.toUtf8()))
+		return false;
+
+	QByteArray buf;
+	qint64 received = 0;
+	while (true) {
+		QByteArray id;
+		quint32 length;
+		if (!readHeader(id, length))
+			return false;
+
+		if (id == "DONE")
+			break;
+		if (id != "DATA")
+			return readFailure(length);
+
+		buf.resize(length);
+		if (!AdbClient::ReadExact(*socket, buf.data(), length))
+			return false;
+		if (dst.write(buf) != length)
+			return false;
+
+		received += length;
+		if (progress && !progress(received, stat.size))
+			return false;
+	}
+
+	LOGD("Sync pulled %lld bytes from %s", received, src.toStdString().c_str());
+	return true;
+}
\ No newline at end of file
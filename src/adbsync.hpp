@@ -0,0 +1,70 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+
+#include <string>
+#include <memory>
+#include <functional>
+
+class QTcpSocket;
+class QFile;
+
+// File transfer over the adb "sync:" service. Pushes are streamed as
+// back-to-back DATA frames without waiting for the device in between, and
+// completion is acknowledged by the device with OKAY after DONE.
+class AdbSync {
+public:
+    struct RemoteStat {
+        bool exists = false;
+        quint32 mode = 0;
+        quint64 size = 0;
+        qint64 mtime = 0;
+    };
+
+    // Returns false to abort the transfer
+    using Progress = std::function<bool(qint64 done, qint64 total)>;
+
+    AdbSync(std::string serial);
+    ~AdbSync();
+    bool Open();
+    void Close();
+    bool Stat(QString path, RemoteStat& stat);
+    bool Push(QFile& src, QString dst, quint32 mode, Progress progress = nullptr);
+    bool Pull(QString src, QFile& dst, Progress progress = nullptr);
+
+private:
+    bool sendRequest(const char* id, const QByteArray& data);
+    bool readHeader(QByteArray& id, quint32& length);
+    bool readFailure(quint32 length);
+    bool flush(qint64 limit);
+
+private:
+    std::string serial;
+    std::unique_ptr<QTcpSocket> socket;
+    bool statV2;
+};
\ No newline at end of file
@@ -0,0 +1,219 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "adbtrace.hpp"
+
+#include <QFile>
+#include <QThread>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+AdbTrace::Scope::Scope(Category category, const std::string& serial, const QString& command)
+	: event{}
+{
+	event.category = category;
+	event.start = Now();
+	event.status = -1;
+	event.thread = reinterpret_cast<quintptr>(QThread::currentThreadId());
+	qstrncpy(event.serial, serial.c_str(), sizeof(event.serial));
+	qstrncpy(event.command, command.toUtf8().constData(), sizeof(event.command));
+}
+
+AdbTrace::Scope::~Scope() {
+	event.duration = Now() - event.start;
+	AdbTrace::getInstance().Record(event);
+}
+
+void AdbTrace::Scope::SetBytes(qint64 bytes) {
+	event.bytes = bytes;
+}
+
+void AdbTrace::Scope::SetStatus(int status) {
+	event.status = status;
+}
+
+AdbTrace::AdbTrace()
+	: slots(std::make_unique<Slot[]>(CAPACITY)), head(0)
+{
+	for (size_t i = 0; i < CAPACITY; i++)
+		slots[i].sequence.store(0, std::memory_order_relaxed);
+}
+
+AdbTrace::~AdbTrace() {
+}
+
+qint64 AdbTrace::Now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void AdbTrace::Record(const Event& event) {
+	// Per slot sequence lock: odd while the event is being written, so a
+	// reader can tell a torn copy from a complete one
+	const quint64 index = head.fetch_add(1, std::memory_order_relaxed);
+	Slot& slot = slots[index % CAPACITY];
+	slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.event = event;
+	slot.sequence.store(index * 2 + 2, std::memory_order_release);
+}
+
+std::vector<AdbTrace::Event> AdbTrace::Snapshot() const {
+	std::vector<Event> events;
+	events.reserve(std::min<quint64>(head.load(std::memory_order_relaxed), CAPACITY));
+	for (size_t i = 0; i < CAPACITY; i++) {
+		const Slot& slot = slots[i];
+		const quint64 before = slot.sequence.load(std::memory_order_acquire);
+		if (before == 0 || before % 2)
+			continue;
+		Event event = slot.event;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == before)
+			events.push_back(event);
+	}
+
+	std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+		return a.start < b.start;
+	});
+	return events;
+}
+
+const char* AdbTrace::CategoryName(Category category) {
+	switch (category) {
+	case Program:
+		return "program";
+	case Shell:
+		return "shell";
+	case Push:
+		return "push";
+	case Pull:
+		return "pull";
+	default:
+		return "unknown";
+	}
+}
+
+QString AdbTrace::CommandType(const Event& event) {
+	// Group privileged commands by what they run rather than by "su"
+	static const QRegularExpression wrapper("^(su 0|run-as \\S+) sh -c '(echo \\S+; )?");
+	if (event.category == Push || event.category == Pull)
+		return CategoryName(event.category);
+
+	QString command = QString::fromUtf8(event.command).remove(wrapper);
+	return QString("%1 %2").arg(CategoryName(event.category), command.section(' ', 0, 0, QString::SectionSkipEmpty));
+}
+
+bool AdbTrace::ExportChromeTrace(const QString& path) const {
+	const std::vector<Event> events = Snapshot();
+	const qint64 origin = events.empty() ? 0 : events.front().start;
+
+	QJsonArray traceEvents;
+	for (const Event& event : events) {
+		QJsonObject args;
+		args.insert("serial", QString::fromUtf8(event.serial));
+		args.insert("bytes", event.bytes);
+		args.insert("status", event.status);
+
+		QJsonObject object;
+		object.insert("name", QString::fromUtf8(event.command));
+		object.insert("cat", CategoryName(event.category));
+		object.insert("ph", "X");
+		object.insert("ts", (event.start - origin) / 1000.0);
+		object.insert("dur", event.duration / 1000.0);
+		object.insert("pid", 1);
+		object.insert("tid", static_cast<qint64>(event.thread));
+		object.insert("args", args);
+		traceEvents.append(object);
+	}
+
+	QJsonObject root;
+	root.insert("traceEvents", traceEvents);
+	root.insert("displayTimeUnit", "ms");
+
+	QFile f(path);
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+	return f.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) > 0;
+}
+
+QString AdbTrace::Summary() const {
+	struct Group {
+		std::vector<qint64> durations;
+		qint64 bytes = 0;
+		int failures = 0;
+	};
+
+	std::map<QString, Group> groups;
+	for (const Event& event : Snapshot()) {
+		Group& group = groups[CommandType(event)];
+		group.durations.push_back(event.duration);
+		group.bytes += event.bytes;
+		if (event.status != 0)
+			group.failures++;
+	}
+
+	// Nearest rank percentile, in milliseconds
+	auto percentile = [](const std::vector<qint64>& sorted, double p) {
+		const size_t rank = static_cast<size_t>(std::max(1.0, std::ceil(p * sorted.size())));
+		return sorted[rank - 1] / 1e6;
+	};
+
+	QString summary = QString("%1 %2 %3 %4 %5 %6 %7 %8  histogram (ms: <1 <2 <4 ... <1024 >=1024)\n")
+		.arg("command", -28).arg("count", 6).arg("fail", 5).arg("p50", 9).arg("p95", 9).arg("p99", 9).arg("max", 9).arg("MB", 9);
+	for (auto& [type, group] : groups) {
+		std::sort(group.durations.begin(), group.durations.end());
+
+		// Power of two buckets from 1 ms up to 1 s
+		int buckets[12] = {};
+		for (qint64 duration : group.durations) {
+			int bucket = 0;
+			while (bucket < 11 && duration >= (1000000ll << bucket))
+				bucket++;
+			buckets[bucket]++;
+		}
+		QStringList histogram;
+		for (int count : buckets)
+			histogram << QString::number(count);
+
+		summary += QString("%1 %2 %3 %4 %5 %6 %7 %8  %9\n")
+			.arg(type.left(28), -28)
+			.arg(group.durations.size(), 6)
+			.arg(group.failures, 5)
+			.arg(percentile(group.durations, 0.50), 9, 'f', 2)
+			.arg(percentile(group.durations, 0.95), 9, 'f', 2)
+			.arg(percentile(group.durations, 0.99), 9, 'f', 2)
+			.arg(group.durations.back() / 1e6, 9, 'f', 2)
+			.arg(group.bytes / 1e6, 9, 'f', 2)
+			.arg(histogram.join(' '));
+	}
+	return summary;
+}
@@ -0,0 +1,94 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "singleton.hpp"
+
+// Timing of every call ADB makes to a device: shell commands, adb program
+// runs and file transfers. Events go into a fixed size ring buffer that any
+// thread can write without locking; the oldest events are overwritten. The
+// buffer can be exported as Chrome trace JSON (chrome://tracing, Perfetto)
+// or summarized as latency percentiles per command type.
+class AdbTrace : public Singleton<AdbTrace> {
+public:
+    enum Category {
+        Program,
+        Shell,
+        Push,
+        Pull,
+    };
+
+    struct Event {
+        Category category;
+        qint64 start;
+        qint64 duration;
+        qint64 bytes;
+        int status;
+        quint64 thread;
+        char serial[48];
+        char command[160];
+    };
+
+    // Records one event covering its own lifetime
+    class Scope {
+    public:
+        Scope(Category category, const std::string& serial, const QString& command);
+        ~Scope();
+        void SetBytes(qint64 bytes);
+        void SetStatus(int status);
+
+    private:
+        Event event;
+    };
+
+    static const size_t CAPACITY = 16384;
+
+    AdbTrace();
+    ~AdbTrace();
+    void Record(const Event& event);
+    std::vector<Event> Snapshot() const;
+    bool ExportChromeTrace(const QString& path) const;
+    QString Summary() const;
+
+    static qint64 Now();
+    static const char* CategoryName(Category category);
+    static QString CommandType(const Event& event);
+
+private:
+    struct Slot {
+        std::atomic<quint64> sequence;
+        Event event;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<quint64> head;
+};
@@ -0,0 +1,386 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "calltreemodel.hpp"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <unordered_set>
+
+#include "common.hpp"
+
+CallTreeModel::CallTreeModel(std::shared_ptr<CaptureFile> capture, QObject* parent)
+	: QAbstractItemModel(parent), capture(capture), reader(*capture)
+{
+}
+
+CallTreeModel::~CallTreeModel() {
+}
+
+// Top level rows are frames, or with a filter the frames with matches
+uint64_t CallTreeModel::frameAt(int row) const {
+	return table ? matchedFrames[row].frame : static_cast<uint64_t>(row);
+}
+
+CallTreeModel::Node* CallTreeModel::frameNode(uint64_t frame) const {
+	auto it = frames.find(frame);
+	return it != frames.end() ? it->second.get() : nullptr;
+}
+
+// Frame indexes carry no pointer, the others point at the node holding their row
+CallTreeModel::Node* CallTreeModel::nodeOf(const QModelIndex& index) const {
+	if (!index.isValid())
+		return nullptr;
+	const Node* parent = static_cast<const Node*>(index.internalPointer());
+	if (!parent)
+		return frameNode(frameAt(index.row()));
+	return index.row() < static_cast<int>(parent->children.size()) ? parent->children[index.row()].group : nullptr;
+}
+
+QModelIndex CallTreeModel::indexOf(const Node* node) const {
+	if (!node->parent)
+		return createIndex(node->row, 0, nullptr);
+	return createIndex(node->row, 0, node->parent);
+}
+
+// With a filter, the first listed frame from frame on
+QModelIndex CallTreeModel::FrameIndex(uint64_t frame) const {
+	if (table) {
+		auto it = std::lower_bound(matchedFrames.begin(), matchedFrames.end(), frame, [](const Match& match, uint64_t frame) {
+			return match.frame < frame;
+		});
+		return it != matchedFrames.end() ? createIndex(static_cast<int>(it - matchedFrames.begin()), 0, nullptr) : QModelIndex();
+	}
+	if (frame >= static_cast<uint64_t>(rowCount()))
+		return QModelIndex();
+	return createIndex(static_cast<int>(frame), 0, nullptr);
+}
+
+QModelIndex CallTreeModel::index(int row, int column, const QModelIndex& parent) const {
+	if (!hasIndex(row, column, parent))
+		return QModelIndex();
+	if (!parent.isValid())
+		return createIndex(row, column, nullptr);
+	Node* node = nodeOf(parent);
+	return node ? createIndex(row, column, node) : QModelIndex();
+}
+
+QModelIndex CallTreeModel::parent(const QModelIndex& child) const {
+	if (!child.isValid() || !child.internalPointer())
+		return QModelIndex();
+	return indexOf(static_cast<const Node*>(child.internalPointer()));
+}
+
+int CallTreeModel::rowCount(const QModelIndex& parent) const {
+	if (parent.column() > 0)
+		return 0;
+	if (!parent.isValid())
+		return static_cast<int>(std::min<size_t>(table ? matchedFrames.size() : capture->GetFrames().size(), INT_MAX));
+	const Node* node = nodeOf(parent);
+	return node ? static_cast<int>(std::min<size_t>(node->children.size(), INT_MAX)) : 0;
+}
+
+int CallTreeModel::columnCount(const QModelIndex&) const {
+	return 1;
+}
+
+// Lets the view draw expanders before anything is read
+bool CallTreeModel::hasChildren(const QModelIndex& parent) const {
+	if (!parent.isValid())
+		return rowCount() > 0;
+	if (!parent.internalPointer())
+		return table || capture->GetFrames()[parent.row()].calls > 0;
+	return nodeOf(parent) != nullptr;
+}
+
+bool CallTreeModel::canFetchMore(const QModelIndex& parent) const {
+	if (!parent.isValid())
+		return false;
+	if (!parent.internalPointer()) {
+		const uint64_t frame = frameAt(parent.row());
+		const Node* node = frameNode(frame);
+		return !node || node->cursor < capture->GetFrames()[frame].endBlock;
+	}
+	// A group still recording gets its calls as its frame is read on
+	const Node* group = nodeOf(parent);
+	return group && !group->complete && group->parent->cursor < capture->GetFrames()[group->frame].endBlock;
+}
+
+void CallTreeModel::fetchMore(const QModelIndex& parent) {
+	if (!canFetchMore(parent))
+		return;
+
+	Node* frame = parent.internalPointer() ? nodeOf(parent)->parent : frameNode(frameAt(parent.row()));
+	if (!frame) {
+		auto node = std::make_unique<Node>();
+		node->frame = frameAt(parent.row());
+		node->row = parent.row();
+		node->cursor = capture->GetFrames()[node->frame].firstBlock;
+		frame = node.get();
+		frames.emplace(node->frame, std::move(node));
+	}
+	read(frame);
+}
+
+// Reads the next FETCH_BLOCKS blocks of a frame. Groups started in this
+// chunk are filled before their row is inserted; calls for groups the view
+// already has are inserted under them. A filtered frame skips ahead to its
+// next match and keeps the matches only.
+void CallTreeModel::read(Node* frame) {
+	QElapsedTimer timer;
+	timer.start();
+	const CaptureFile::Frame& info = capture->GetFrames()[frame->frame];
+	uint64_t begin = frame->cursor;
+
+	std::span<const uint32_t> blocks;
+	std::span<const uint32_t> pending;
+	if (table) {
+		const Match& match = matchedFrames[frame->row];
+		blocks = table->GetBlocks();
+		pending = std::span<const uint32_t>(matches).subspan(match.first, match.end - match.first);
+		pending = pending.subspan(std::partition_point(pending.begin(), pending.end(), [&](uint32_t row) {
+			return blocks[row] < begin;
+		}) - pending.begin());
+		if (pending.empty()) {
+			frame->cursor = info.endBlock;
+			return;
+		}
+		begin = blocks[pending.front()];
+	}
+	const uint64_t end = std::min(begin + FETCH_BLOCKS, info.endBlock);
+
+	auto decode = [&](const FrameReader::Call& call) {
+		vkdecode::DecodedCall* decoded = vkdecode::DecodeCall(call.id, call.ok ? call.params : nullptr, call.paramSize, frame->arena, names);
+		decoded->thread = call.thread;
+		decoded->object = call.object;
+		return decoded;
+	};
+
+	std::vector<Row> rows;
+	std::map<Node*, std::vector<Row>> grown;
+	std::unordered_set<const Node*> started;
+	reader.ReadBlocks(begin, end, [&](const FrameReader::Call& call) {
+		if (table) {
+			while (!pending.empty() && blocks[pending.front()] < call.block)
+				pending = pending.subspan(1);
+			if (pending.empty())
+				return false;
+			if (blocks[pending.front()] == call.block)
+				rows.push_back({ call.block, nullptr, decode(call) });
+			return true;
+		}
+
+		vkdecode::DecodedCall* decoded = decode(call);
+
+		// Command buffer calls take the buffer first. Handle IDs are unique
+		// in a capture, so other calls never match a recording buffer.
+		const uint64_t handle = call.ok && call.paramSize >= sizeof(uint64_t) ? gfxr::Read<uint64_t>(call.params) : 0;
+		auto recording = frame->recording.find(handle);
+		if (call.id == gfxr::API_CALL_VK_BEGIN_COMMAND_BUFFER) {
+			// A buffer begun again without an end is left as it is
+			if (recording != frame->recording.end())
+				recording->second->complete = true;
+
+			auto group = std::make_unique<Node>();
+			group->parent = frame;
+			group->frame = frame->frame;
+			group->row = static_cast<int>(frame->children.size() + rows.size());
+			group->handle = handle;
+			group->children.push_back({ call.block, nullptr, decoded });
+			rows.push_back({ call.block, group.get(), decoded });
+			frame->recording[handle] = group.get();
+			started.insert(group.get());
+			frame->groups.push_back(std::move(group));
+			return true;
+		}
+
+		if (recording == frame->recording.end()) {
+			rows.push_back({ call.block, nullptr, decoded });
+			return true;
+		}
+
+		Node* group = recording->second;
+		(started.count(group) ? group->children : grown[group]).push_back({ call.block, nullptr, decoded });
+		if (call.id == gfxr::API_CALL_VK_END_COMMAND_BUFFER) {
+			group->complete = true;
+			frame->recording.erase(recording);
+		}
+		return true;
+	});
+	frame->cursor = end;
+	if (table && blocks[matches[matchedFrames[frame->row].end - 1]] < end)
+		frame->cursor = info.endBlock;
+
+	for (auto& [group, calls] : grown) {
+		const int first = static_cast<int>(group->children.size());
+		beginInsertRows(indexOf(group), first, first + static_cast<int>(calls.size()) - 1);
+		group->children.insert(group->children.end(), calls.begin(), calls.end());
+		endInsertRows();
+	}
+	if (!rows.empty()) {
+		const int first = static_cast<int>(frame->children.size());
+		beginInsertRows(indexOf(frame), first, first + static_cast<int>(rows.size()) - 1);
+		frame->children.insert(frame->children.end(), rows.begin(), rows.end());
+		endInsertRows();
+	}
+	LOGD("Read blocks %llu to %llu of frame %llu in %lld ms", static_cast<unsigned long long>(begin),
+		static_cast<unsigned long long>(end), static_cast<unsigned long long>(frame->frame + 1), timer.elapsed());
+}
+
+void CallTreeModel::ReleaseFrame(const QModelIndex& index) {
+	if (!index.isValid() || index.internalPointer())
+		return;
+	auto it = frames.find(frameAt(index.row()));
+	if (it == frames.end())
+		return;
+
+	Node* frame = it->second.get();
+	if (!frame->children.empty()) {
+		beginRemoveRows(index, 0, static_cast<int>(frame->children.size()) - 1);
+		frame->children.clear();
+		endRemoveRows();
+	}
+	frames.erase(it);
+}
+
+// rows are the table's Filter() result, in order
+void CallTreeModel::SetFilter(std::shared_ptr<const vkdecode::CallTable> filterTable, std::vector<uint32_t> rows) {
+	beginResetModel();
+	frames.clear();
+	table = std::move(filterTable);
+	matches = std::move(rows);
+	matchedFrames.clear();
+	const std::span<const uint32_t> frameColumn = table->GetFrames();
+	for (size_t i = 0; i < matches.size(); i++) {
+		const uint64_t frame = frameColumn[matches[i]];
+		if (matchedFrames.empty() || matchedFrames.back().frame != frame)
+			matchedFrames.push_back({ frame, i, i });
+		matchedFrames.back().end = i + 1;
+	}
+	endResetModel();
+}
+
+void CallTreeModel::ClearFilter() {
+	beginResetModel();
+	frames.clear();
+	table.reset();
+	matches.clear();
+	matchedFrames.clear();
+	endResetModel();
+}
+
+bool CallTreeModel::IsFiltered() const {
+	return table != nullptr;
+}
+
+// Decodes every call of the capture into columns, on any thread. That is
+// a read of the whole capture, so it is only done for the first filter.
+std::shared_ptr<const vkdecode::CallTable> CallTreeModel::BuildCallTable(const CaptureFile& capture, std::stop_token stop) {
+	const std::span<const CaptureFile::Frame> frames = capture.GetFrames();
+	if (capture.GetBlocks().size() > UINT32_MAX) {
+		LOGW("Capture has too many blocks to filter");
+		return nullptr;
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	auto table = std::make_shared<vkdecode::CallTable>();
+	uint64_t calls = 0;
+	for (const CaptureFile::Frame& frame : frames)
+		calls += frame.calls;
+	table->Reserve(calls);
+
+	FrameReader reader(capture);
+	const bool done = reader.Read(0, frames.size(), [&](const FrameReader::Call& call) {
+		if (stop.stop_requested())
+			return false;
+		vkdecode::Value values[vkdecode::MAX_VALUES];
+		const vkdecode::CallInfo* info = call.ok ? vkdecode::FindCall(call.id) : nullptr;
+		const size_t count = info ? info->decode(call.params, call.paramSize, values) : 0;
+		table->Append(call.id, static_cast<uint32_t>(call.frame), call.thread, static_cast<uint32_t>(call.block), values, count);
+		return true;
+	});
+	if (!done)
+		return nullptr;
+
+	LOGD("Built call table of %zu calls, %.1f MB in %lld ms", table->GetRowCount(), table->GetBytes() / 1e6, timer.elapsed());
+	return table;
+}
+
+const QString& CallTreeModel::describeCall(const Row& row) const {
+	auto cached = cache.find(row.block);
+	if (cached != cache.end()) {
+		lru.splice(lru.begin(), lru, cached->second);
+		return cached->second->second;
+	}
+
+	// Unknown calls show what the call prefix tells
+	const vkdecode::DecodedCall& call = *row.call;
+	QString text = QString::fromStdString(vkdecode::FormatCall(call));
+	if (!call.info)
+		text += QString("  thread %1  %2 bytes").arg(call.thread).arg(call.paramSize);
+	if (!call.info && call.object)
+		text += QString("  object %1").arg(call.object);
+
+	const uint64_t block = row.block;
+	lru.emplace_front(block, std::move(text));
+	cache[block] = lru.begin();
+	if (lru.size() > CACHE_SIZE) {
+		cache.erase(lru.back().first);
+		lru.pop_back();
+	}
+	return lru.front().second;
+}
+
+QVariant CallTreeModel::data(const QModelIndex& index, int role) const {
+	if (!index.isValid() || role != Qt::DisplayRole)
+		return QVariant();
+
+	const Node* parent = static_cast<const Node*>(index.internalPointer());
+	if (!parent) {
+		const uint64_t number = frameAt(index.row());
+		const CaptureFile::Frame& frame = capture->GetFrames()[number];
+		if (table) {
+			const Match& match = matchedFrames[index.row()];
+			return QString("Frame %1  %2 of %3 calls").arg(number + 1).arg(match.end - match.first).arg(frame.calls);
+		}
+		return QString("Frame %1  %2 calls, %3 KB").arg(number + 1).arg(frame.calls).arg(frame.bytes / 1e3, 0, 'f', 1);
+	}
+	if (index.row() >= static_cast<int>(parent->children.size()))
+		return QVariant();
+
+	const Row& row = parent->children[index.row()];
+	if (row.group)
+		return QString("Command buffer %1  %2 calls").arg(row.group->handle).arg(row.group->children.size());
+	return describeCall(row);
+}
+
+QVariant CallTreeModel::headerData(int section, Qt::Orientation orientation, int role) const {
+	if (section != 0 || orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QVariant();
+	return QString("Call");
+}
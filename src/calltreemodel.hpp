@@ -0,0 +1,131 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QAbstractItemModel>
+#include <QString>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <stop_token>
+#include <unordered_map>
+#include <vector>
+
+#include "capturefile.hpp"
+#include "framereader.hpp"
+#include "vulkancalls.hpp"
+#include "calltable.hpp"
+
+// API calls of a capture as frame > command buffer > call. Frame rows cost
+// nothing beyond the capture index; a frame's calls are read in chunks by
+// fetchMore() as the view asks for them, and dropped again by
+// ReleaseFrame() when it is collapsed. Calls between vkBeginCommandBuffer
+// and vkEndCommandBuffer of a command buffer are grouped under it, even
+// when several buffers record interleaved; anything else (queue submits,
+// presents, ...) sits under the frame. Calls are decoded as they are read
+// into an arena per frame, which goes away in one piece with the frame;
+// names of unknown calls are interned. Display text is built on first use
+// and kept in a small LRU cache, so memory depends on the frames expanded,
+// not the capture size. With a filter set, only frames with matching calls
+// are listed, and under them only the matching calls, without command
+// buffer groups.
+class CallTreeModel : public QAbstractItemModel {
+    Q_OBJECT
+
+public:
+    static const size_t CACHE_SIZE = 8192;
+    static const uint64_t FETCH_BLOCKS = 4096;
+
+    CallTreeModel(std::shared_ptr<CaptureFile> capture, QObject* parent = nullptr);
+    ~CallTreeModel();
+    QModelIndex FrameIndex(uint64_t frame) const;
+    void ReleaseFrame(const QModelIndex& index);
+    void SetFilter(std::shared_ptr<const vkdecode::CallTable> table, std::vector<uint32_t> rows);
+    void ClearFilter();
+    bool IsFiltered() const;
+    static std::shared_ptr<const vkdecode::CallTable> BuildCallTable(const CaptureFile& capture, std::stop_token stop);
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+private:
+    struct Node;
+
+    // A call, or a command buffer group starting at its begin call
+    struct Row {
+        uint64_t block;
+        Node* group;
+        const vkdecode::DecodedCall* call;
+    };
+
+    // A loaded frame, or a command buffer group inside one
+    struct Node {
+        Node* parent = nullptr;
+        uint64_t frame = 0;
+        int row = 0;
+        uint64_t handle = 0;
+        bool complete = false;
+        std::vector<Row> children;
+        // Frames only: next block to read, the group recording into each
+        // command buffer handle, and the groups themselves
+        uint64_t cursor = 0;
+        std::unordered_map<uint64_t, Node*> recording;
+        std::vector<std::unique_ptr<Node>> groups;
+        Arena arena;
+    };
+
+    // A frame with filter matches, rows [first, end) of the matches
+    struct Match {
+        uint64_t frame;
+        size_t first;
+        size_t end;
+    };
+
+    uint64_t frameAt(int row) const;
+    Node* frameNode(uint64_t frame) const;
+    Node* nodeOf(const QModelIndex& index) const;
+    QModelIndex indexOf(const Node* node) const;
+    void read(Node* frame);
+    const QString& describeCall(const Row& row) const;
+
+private:
+    std::shared_ptr<CaptureFile> capture;
+    FrameReader reader;
+    StringTable names;
+    std::unordered_map<uint64_t, std::unique_ptr<Node>> frames;
+    std::shared_ptr<const vkdecode::CallTable> table;
+    std::vector<uint32_t> matches;
+    std::vector<Match> matchedFrames;
+    mutable std::list<std::pair<uint64_t, QString>> lru;
+    mutable std::unordered_map<uint64_t, std::list<std::pair<uint64_t, QString>>::iterator> cache;
+};
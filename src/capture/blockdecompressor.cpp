@@ -0,0 +1,327 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "blockdecompressor.hpp"
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(GFXR_VIEWER_HAS_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(GFXR_VIEWER_HAS_LZ4)
+#include <lz4.h>
+#endif
+#if defined(GFXR_VIEWER_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+#include "common.hpp"
+
+// Larger uncompressed sizes are taken as a corrupt header, not allocated
+static const uint64_t MAX_BLOCK_SIZE = 1ull << 30;
+static const int SLOTS_PER_WORKER = 4;
+
+static bool decompressBlock(gfxr::Compression compression, const uint8_t* src, uint64_t srcSize, uint8_t* dst, uint64_t dstSize) {
+	switch (compression) {
+	case gfxr::Compression::Zlib:
+	{
+#if defined(GFXR_VIEWER_HAS_ZLIB)
+		uLongf length = static_cast<uLongf>(dstSize);
+		return uncompress(dst, &length, src, static_cast<uLong>(srcSize)) == Z_OK && length == dstSize;
+#else
+		// qUncompress wants the expected size as a big endian prefix
+		QByteArray input;
+		input.reserve(4 + srcSize);
+		char prefix[4];
+		qToBigEndian<quint32>(static_cast<quint32>(dstSize), prefix);
+		input.append(prefix, sizeof(prefix));
+		input.append(reinterpret_cast<const char*>(src), srcSize);
+		const QByteArray output = qUncompress(input);
+		if (static_cast<uint64_t>(output.size()) != dstSize)
+			return false;
+		memcpy(dst, output.constData(), dstSize);
+		return true;
+#endif
+	}
+	case gfxr::Compression::Lz4:
+	{
+#if defined(GFXR_VIEWER_HAS_LZ4)
+		return LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+			static_cast<int>(srcSize), static_cast<int>(dstSize)) == static_cast<int>(dstSize);
+#else
+		return false;
+#endif
+	}
+	case gfxr::Compression::Zstd:
+	{
+#if defined(GFXR_VIEWER_HAS_ZSTD)
+		return ZSTD_decompress(dst, dstSize, src, srcSize) == dstSize;
+#else
+		return false;
+#endif
+	}
+	default:
+		return false;
+	}
+}
+
+double BlockDecompressor::Stats::Throughput() const {
+	return seconds > 0.0 ? bytes / seconds : 0.0;
+}
+
+double BlockDecompressor::Stats::ThroughputPerCore() const {
+	return busySeconds > 0.0 ? bytes / busySeconds : 0.0;
+}
+
+BlockDecompressor::BlockDecompressor(const CaptureFile& capture, int workers, uint64_t budget)
+	: capture(capture), budget(budget), cursor(0), next(0), end(0), reserved(0), stopped(false), busyNs(0)
+{
+	pool.setMaxThreadCount(workers > 0 ? workers : std::max(1, QThread::idealThreadCount()));
+	slots.resize(pool.maxThreadCount() * SLOTS_PER_WORKER);
+}
+
+BlockDecompressor::~BlockDecompressor() {
+	pool.waitForDone();
+}
+
+BlockDecompressor::Stats BlockDecompressor::GetStats() const {
+	return stats;
+}
+
+bool BlockDecompressor::IsSupported(gfxr::Compression compression) {
+	switch (compression) {
+	case gfxr::Compression::None:
+	case gfxr::Compression::Zlib:
+		return true;
+#if defined(GFXR_VIEWER_HAS_LZ4)
+	case gfxr::Compression::Lz4:
+		return true;
+#endif
+#if defined(GFXR_VIEWER_HAS_ZSTD)
+	case gfxr::Compression::Zstd:
+		return true;
+#endif
+	default:
+		return false;
+	}
+}
+
+BlockDecompressor::Layout BlockDecompressor::layout(const CaptureFile::Block& block) const {
+	Layout layout;
+	switch (block.BaseType()) {
+	case gfxr::BlockType::FunctionCall:
+		layout.prefix = gfxr::FUNCTION_CALL_PREFIX;
+		break;
+	case gfxr::BlockType::MethodCall:
+		layout.prefix = gfxr::METHOD_CALL_PREFIX;
+		break;
+	default:
+		// Meta data blocks keep their own fields ahead of compressed data,
+		// they are handed over whole and marked as not decoded
+		layout.valid = !block.IsCompressed();
+		layout.size = block.size;
+		return layout;
+	}
+
+	layout.compressed = block.IsCompressed();
+	if (!layout.compressed) {
+		layout.valid = block.size >= layout.prefix;
+		layout.size = layout.valid ? block.size - layout.prefix : 0;
+		return layout;
+	}
+
+	layout.valid = block.size >= layout.prefix + gfxr::UNCOMPRESSED_SIZE_FIELD;
+	if (layout.valid)
+		layout.size = gfxr::Read<uint64_t>(capture.GetPayload(block) + layout.prefix);
+	layout.prefix += gfxr::UNCOMPRESSED_SIZE_FIELD;
+	layout.valid = layout.valid && layout.size <= MAX_BLOCK_SIZE;
+	if (!layout.valid)
+		layout.compressed = false;
+	return layout;
+}
+
+void BlockDecompressor::decode(size_t index, const Layout& layout, Buffer& buffer, Result& result) {
+	const CaptureFile::Block& block = capture.GetBlocks()[index];
+	const uint8_t* payload = capture.GetPayload(block);
+	result.index = index;
+
+	if (!layout.valid) {
+		result.data = payload;
+		result.size = block.size;
+		result.ok = false;
+		return;
+	}
+
+	if (!layout.compressed) {
+		result.data = payload + layout.prefix;
+		result.size = layout.size;
+		result.ok = true;
+		return;
+	}
+
+	if (buffer.capacity < layout.size) {
+		buffer.data.reset(new uint8_t[layout.size]);
+		buffer.capacity = layout.size;
+	}
+	result.data = buffer.data.get();
+	result.size = layout.size;
+	result.ok = decompressBlock(capture.GetHeader().compression, payload + layout.prefix, block.size - layout.prefix, buffer.data.get(), layout.size);
+}
+
+void BlockDecompressor::work() {
+	const std::span<const CaptureFile::Block> blocks = capture.GetBlocks();
+	for (;;) {
+		size_t index = 0;
+		uint64_t need = 0;
+		Layout blockLayout;
+		Buffer buffer;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			claimable.wait(lock, [&] {
+				if (stopped || cursor >= end)
+					return true;
+				if (cursor >= next + slots.size())
+					return false;
+				blockLayout = layout(blocks[cursor]);
+				need = blockLayout.compressed ? blockLayout.size : 0;
+				// A block larger than the budget still goes through on its own
+				return reserved == 0 || reserved + need <= budget;
+			});
+			if (stopped || cursor >= end)
+				return;
+
+			index = cursor++;
+			reserved += need;
+			if (need > 0 && !buffers.empty()) {
+				buffer = std::move(buffers.back());
+				buffers.pop_back();
+			}
+		}
+
+		Result result;
+		QElapsedTimer timer;
+		timer.start();
+		decode(index, blockLayout, buffer, result);
+		busyNs += timer.nsecsElapsed();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			Slot& slot = slots[index % slots.size()];
+			slot.result = result;
+			slot.buffer = std::move(buffer);
+			slot.reserved = need;
+			slot.ready = true;
+			if (blockLayout.compressed) {
+				stats.compressedBlocks++;
+				stats.compressedBytes += blocks[index].size;
+			}
+		}
+		ready.notify_all();
+	}
+}
+
+bool BlockDecompressor::Decompress(size_t begin, size_t end, Sink sink) {
+	const std::span<const CaptureFile::Block> blocks = capture.GetBlocks();
+	end = std::min(end, blocks.size());
+	begin = std::min(begin, end);
+
+	QElapsedTimer timer;
+	timer.start();
+	stats = Stats();
+	busyNs = 0;
+	bool complete = true;
+
+	if (capture.GetHeader().compression == gfxr::Compression::None) {
+		// Nothing to inflate, the payloads are handed out straight from the mapping
+		Buffer none;
+		for (size_t i = begin; i < end && complete; i++) {
+			Result result;
+			decode(i, layout(blocks[i]), none, result);
+			stats.blocks++;
+			stats.bytes += result.size;
+			complete = sink(result);
+		}
+	}
+	else {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			cursor = begin;
+			next = begin;
+			this->end = end;
+			reserved = 0;
+			stopped = false;
+		}
+		stats.workers = pool.maxThreadCount();
+		for (int i = 0; i < stats.workers; i++)
+			pool.start([this] { work(); });
+
+		while (complete && next < end) {
+			std::unique_lock<std::mutex> lock(mutex);
+			Slot& slot = slots[next % slots.size()];
+			ready.wait(lock, [&] { return slot.ready; });
+			lock.unlock();
+
+			stats.blocks++;
+			stats.bytes += slot.result.size;
+			complete = sink(slot.result);
+
+			lock.lock();
+			reserved -= slot.reserved;
+			if (slot.buffer.data)
+				buffers.push_back(std::move(slot.buffer));
+			slot = Slot();
+			next++;
+			lock.unlock();
+			claimable.notify_all();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopped = true;
+		}
+		claimable.notify_all();
+		pool.waitForDone();
+
+		// Results decoded past an early stop are dropped
+		for (Slot& slot : slots) {
+			if (slot.buffer.data)
+				buffers.push_back(std::move(slot.buffer));
+			slot = Slot();
+		}
+		reserved = 0;
+	}
+
+	stats.seconds = timer.nsecsElapsed() / 1e9;
+	stats.busySeconds = busyNs / 1e9;
+	LOGD("Decompressed %llu blocks (%llu compressed) into %.1f MB in %.1f ms, %.1f MB/s per core on %d workers",
+		static_cast<unsigned long long>(stats.blocks), static_cast<unsigned long long>(stats.compressedBlocks),
+		stats.bytes / 1e6, stats.seconds * 1e3, stats.ThroughputPerCore() / 1e6, stats.workers);
+	return complete;
+}
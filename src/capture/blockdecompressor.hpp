@@ -0,0 +1,117 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QThreadPool>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+
+#include "capturefile.hpp"
+
+// Decompresses a range of capture blocks on a thread pool and hands the
+// parameter data of each block to a sink, strictly in block order. Workers
+// claim the next block from a shared cursor, so a run of large blocks does
+// not hold up the others. Output buffers are pooled and reused once the
+// sink returns, and at most the byte budget of decompressed data is in
+// flight however long the range is. Uncompressed blocks are not copied,
+// the sink sees the mapped payload.
+class BlockDecompressor {
+public:
+    struct Result {
+        size_t index = 0;
+        const uint8_t* data = nullptr;
+        uint64_t size = 0;
+        bool ok = false;
+    };
+
+    struct Stats {
+        int workers = 0;
+        uint64_t blocks = 0;
+        uint64_t compressedBlocks = 0;
+        uint64_t compressedBytes = 0;
+        uint64_t bytes = 0;
+        double seconds = 0.0;
+        double busySeconds = 0.0;
+
+        double Throughput() const;
+        double ThroughputPerCore() const;
+    };
+
+    // Return false to stop early
+    using Sink = std::function<bool(const Result& result)>;
+
+    BlockDecompressor(const CaptureFile& capture, int workers = 0, uint64_t budget = 256 << 20);
+    ~BlockDecompressor();
+    bool Decompress(size_t begin, size_t end, Sink sink);
+    Stats GetStats() const;
+    static bool IsSupported(gfxr::Compression compression);
+
+private:
+    struct Buffer {
+        std::unique_ptr<uint8_t[]> data;
+        uint64_t capacity = 0;
+    };
+
+    struct Slot {
+        Result result;
+        Buffer buffer;
+        uint64_t reserved = 0;
+        bool ready = false;
+    };
+
+    struct Layout {
+        uint64_t prefix = 0;
+        uint64_t size = 0;
+        bool compressed = false;
+        bool valid = true;
+    };
+
+    Layout layout(const CaptureFile::Block& block) const;
+    void work();
+    void decode(size_t index, const Layout& layout, Buffer& buffer, Result& result);
+
+private:
+    const CaptureFile& capture;
+    QThreadPool pool;
+    uint64_t budget;
+    std::mutex mutex;
+    std::condition_variable claimable;
+    std::condition_variable ready;
+    std::vector<Slot> slots;
+    std::vector<Buffer> buffers;
+    size_t cursor;
+    size_t next;
+    size_t end;
+    uint64_t reserved;
+    bool stopped;
+    std::atomic<uint64_t> busyNs;
+    Stats stats;
+};
@@ -0,0 +1,171 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "blockparser.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+BlockParser::BlockParser()
+	: state(State::FileHeader), headerSize(gfxr::FILE_HEADER_SIZE), blockType(0), blockSize(0), remaining(0), peekSize(0), markers(false)
+{
+}
+
+BlockParser::~BlockParser() {
+}
+
+bool BlockParser::IsValid() const {
+	return state != State::Invalid;
+}
+
+const BlockParser::Stats& BlockParser::GetStats() const {
+	return stats;
+}
+
+bool BlockParser::Feed(const char* data, uint64_t size) {
+	stats.bytes += size;
+
+	while (size > 0) {
+		switch (state) {
+		case State::FileHeader:
+		case State::Options:
+		case State::BlockHeader:
+		{
+			const uint64_t take = std::min<uint64_t>(headerSize - header.size(), size);
+			header.insert(header.end(), data, data + take);
+			data += take;
+			size -= take;
+			if (header.size() < headerSize)
+				break;
+
+			if (state == State::BlockHeader)
+				onBlockHeader();
+			else
+				onFileHeader();
+			break;
+		}
+		case State::Payload:
+		{
+			const uint64_t take = std::min(remaining, size);
+			if (peekSize < PEEK_SIZE) {
+				const size_t copy = static_cast<size_t>(std::min<uint64_t>(PEEK_SIZE - peekSize, take));
+				memcpy(peek + peekSize, data, copy);
+				peekSize += copy;
+			}
+			data += take;
+			size -= take;
+			remaining -= take;
+			if (remaining == 0)
+				onBlockEnd();
+			break;
+		}
+		case State::Invalid:
+			return false;
+		}
+	}
+
+	return state != State::Invalid;
+}
+
+void BlockParser::onFileHeader() {
+	if (state == State::FileHeader) {
+		if (gfxr::Read<uint32_t>(header.data()) != gfxr::FOURCC) {
+			state = State::Invalid;
+			return;
+		}
+		stats.majorVersion = gfxr::Read<uint32_t>(header.data() + 4);
+		stats.minorVersion = gfxr::Read<uint32_t>(header.data() + 8);
+		const uint32_t numOptions = gfxr::Read<uint32_t>(header.data() + 12);
+		if (numOptions > 0) {
+			state = State::Options;
+			headerSize = gfxr::FILE_HEADER_SIZE + numOptions * gfxr::OPTION_SIZE;
+			return;
+		}
+	}
+
+	for (uint64_t off = gfxr::FILE_HEADER_SIZE; off + gfxr::OPTION_SIZE <= header.size(); off += gfxr::OPTION_SIZE) {
+		const auto key = static_cast<gfxr::OptionKey>(gfxr::Read<uint32_t>(header.data() + off));
+		if (key == gfxr::OptionKey::CompressionType)
+			stats.compression = static_cast<gfxr::Compression>(gfxr::Read<uint32_t>(header.data() + off + 4));
+	}
+
+	stats.headerValid = true;
+	header.clear();
+	headerSize = gfxr::BLOCK_HEADER_SIZE;
+	state = State::BlockHeader;
+}
+
+void BlockParser::onBlockHeader() {
+	blockSize = gfxr::Read<uint64_t>(header.data());
+	blockType = gfxr::Read<uint32_t>(header.data() + 8);
+	header.clear();
+
+	remaining = blockSize;
+	peekSize = 0;
+	state = State::Payload;
+	if (remaining == 0)
+		onBlockEnd();
+}
+
+void BlockParser::onBlockEnd() {
+	const uint64_t total = gfxr::BLOCK_HEADER_SIZE + blockSize;
+	stats.blocks++;
+	stats.blockCounts[blockType]++;
+	stats.currentFrameBytes += total;
+
+	switch (gfxr::BaseType(blockType)) {
+	case gfxr::BlockType::FunctionCall:
+		// Captures without frame markers end frames at vkQueuePresentKHR,
+		// like CaptureFile does
+		stats.functionCalls++;
+		if (!markers && peekSize >= 4 && gfxr::Read<uint32_t>(peek) == gfxr::API_CALL_VK_QUEUE_PRESENT_KHR)
+			onFrameEnd();
+		break;
+	case gfxr::BlockType::FrameMarker:
+		// Marker payload: uint32 marker type, uint64 frame number
+		if (peekSize >= 4 && static_cast<gfxr::MarkerType>(gfxr::Read<uint32_t>(peek)) == gfxr::MarkerType::End) {
+			// The first marker takes over from presents, its frame covers
+			// everything before it
+			if (!markers) {
+				markers = true;
+				stats.frames = 0;
+				stats.currentFrameBytes += stats.frameBytes;
+				stats.frameBytes = 0;
+			}
+			onFrameEnd();
+		}
+		break;
+	default:
+		break;
+	}
+
+	state = State::BlockHeader;
+}
+
+void BlockParser::onFrameEnd() {
+	stats.frames++;
+	stats.frameBytes += stats.currentFrameBytes;
+	stats.lastFrameBytes = stats.currentFrameBytes;
+	stats.currentFrameBytes = 0;
+}
\ No newline at end of file
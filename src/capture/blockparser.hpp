@@ -0,0 +1,88 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "gfxr.hpp"
+
+// Incremental parser for a capture that arrives in arbitrary pieces, e.g. a
+// file still being written on the device. Only block headers and the first
+// few payload bytes are kept, so memory stays constant however long the
+// stream gets.
+class BlockParser {
+public:
+    struct Stats {
+        bool headerValid = false;
+        uint32_t majorVersion = 0;
+        uint32_t minorVersion = 0;
+        gfxr::Compression compression = gfxr::Compression::None;
+        uint64_t bytes = 0;
+        uint64_t blocks = 0;
+        uint64_t functionCalls = 0;
+        uint64_t frames = 0;
+        uint64_t frameBytes = 0;
+        uint64_t lastFrameBytes = 0;
+        uint64_t currentFrameBytes = 0;
+        std::map<uint32_t, uint64_t> blockCounts;
+    };
+
+    BlockParser();
+    ~BlockParser();
+    bool Feed(const char* data, uint64_t size);
+    bool IsValid() const;
+    const Stats& GetStats() const;
+
+private:
+    enum class State {
+        FileHeader,
+        Options,
+        BlockHeader,
+        Payload,
+        Invalid,
+    };
+
+    void onFileHeader();
+    void onBlockHeader();
+    void onBlockEnd();
+    void onFrameEnd();
+
+private:
+    static const size_t PEEK_SIZE = 16;
+
+    State state;
+    std::vector<char> header;
+    uint64_t headerSize;
+    uint32_t blockType;
+    uint64_t blockSize;
+    uint64_t remaining;
+    char peek[PEEK_SIZE];
+    size_t peekSize;
+    bool markers;
+    Stats stats;
+};
\ No newline at end of file
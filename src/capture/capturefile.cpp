@@ -0,0 +1,278 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "capturefile.hpp"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QDateTime>
+
+#include <algorithm>
+
+#include "captureindex.hpp"
+#include "common.hpp"
+
+gfxr::BlockType CaptureFile::Block::BaseType() const {
+	return gfxr::BaseType(type);
+}
+
+bool CaptureFile::Block::IsCompressed() const {
+	return gfxr::IsCompressed(type);
+}
+
+CaptureFile::CaptureFile()
+	: data(nullptr), size(0), truncated(false), calls(0), compressedBlocks(0)
+{
+}
+
+CaptureFile::~CaptureFile() {
+	Close();
+}
+
+void CaptureFile::Close() {
+	if (data)
+		file.unmap(const_cast<uint8_t*>(data));
+	file.close();
+	data = nullptr;
+	size = 0;
+	truncated = false;
+	calls = 0;
+	compressedBlocks = 0;
+	header = Header();
+	blocks = {};
+	frames = {};
+	index.reset();
+	ownBlocks.clear();
+	ownBlocks.shrink_to_fit();
+	ownFrames.clear();
+	ownFrames.shrink_to_fit();
+}
+
+bool CaptureFile::IsOpen() const {
+	return data != nullptr;
+}
+
+QString CaptureFile::GetPath() const {
+	return file.fileName();
+}
+
+QString CaptureFile::GetError() const {
+	return error;
+}
+
+uint64_t CaptureFile::GetSize() const {
+	return size;
+}
+
+bool CaptureFile::IsTruncated() const {
+	return truncated;
+}
+
+const CaptureFile::Header& CaptureFile::GetHeader() const {
+	return header;
+}
+
+std::span<const CaptureFile::Block> CaptureFile::GetBlocks() const {
+	return blocks;
+}
+
+std::span<const CaptureFile::Frame> CaptureFile::GetFrames() const {
+	return frames;
+}
+
+// Frames are sorted and contiguous, the one holding a block is the last
+// one starting at or before it; GetFrames().size() when there is none
+uint64_t CaptureFile::FindFrame(uint64_t block) const {
+	auto it = std::upper_bound(frames.begin(), frames.end(), block, [](uint64_t block, const Frame& frame) {
+		return block < frame.firstBlock;
+	});
+	if (it == frames.begin() || block >= std::prev(it)->endBlock)
+		return frames.size();
+	return std::prev(it) - frames.begin();
+}
+
+// Blocks [begin, end) covering frames [first, end), clamped to the capture
+std::pair<uint64_t, uint64_t> CaptureFile::GetFrameBlocks(uint64_t first, uint64_t end) const {
+	end = std::min<uint64_t>(end, frames.size());
+	if (first >= end)
+		return { 0, 0 };
+	return { frames[first].firstBlock, frames[end - 1].endBlock };
+}
+
+bool CaptureFile::IsIndexLoaded() const {
+	return index != nullptr;
+}
+
+uint64_t CaptureFile::GetCallCount() const {
+	return calls;
+}
+
+uint64_t CaptureFile::GetCompressedBlockCount() const {
+	return compressedBlocks;
+}
+
+const uint8_t* CaptureFile::GetPayload(const Block& block) const {
+	return data + block.offset + gfxr::BLOCK_HEADER_SIZE;
+}
+
+bool CaptureFile::fail(QString error) {
+	LOGD("%s", error.toStdString().c_str());
+	Close();
+	this->error = error;
+	return false;
+}
+
+bool CaptureFile::Open(const QString& path) {
+	Close();
+	error.clear();
+
+	QElapsedTimer timer;
+	timer.start();
+
+	file.setFileName(path);
+	if (!file.open(QIODevice::ReadOnly))
+		return fail(QString("Cannot open %1: %2").arg(path, file.errorString()));
+
+	size = file.size();
+	if (size < gfxr::FILE_HEADER_SIZE)
+		return fail(QString("%1 is too small to be a capture").arg(path));
+
+	data = file.map(0, size);
+	if (!data)
+		return fail(QString("Cannot map %1: %2").arg(path, file.errorString()));
+
+	uint64_t offset = 0;
+	if (!readHeader(offset))
+		return false;
+
+	const qint64 mtime = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+	index = std::make_unique<CaptureIndex>();
+	if (index->Load(path, data, size, mtime, header)) {
+		blocks = index->GetBlocks();
+		frames = index->GetFrames();
+		truncated = index->IsTruncated();
+		compressedBlocks = index->GetCompressedBlockCount();
+		countCalls();
+		LOGD("Mapped index of %s with %zu blocks in %lld ms", path.toStdString().c_str(), blocks.size(), timer.elapsed());
+		return true;
+	}
+	index.reset();
+
+	indexBlocks(offset);
+	indexFrames();
+	countCalls();
+	LOGD("Indexed %zu blocks and %zu frames of %s in %lld ms%s", blocks.size(), frames.size(), path.toStdString().c_str(),
+		timer.elapsed(), truncated ? ", last block cut short" : "");
+
+	CaptureIndex::Save(path, data, size, mtime, header, blocks, frames, truncated, compressedBlocks);
+	return true;
+}
+
+bool CaptureFile::readHeader(uint64_t& offset) {
+	if (gfxr::Read<uint32_t>(data) != gfxr::FOURCC)
+		return fail(QString("%1 is not a GFXReconstruct capture").arg(file.fileName()));
+
+	header.majorVersion = gfxr::Read<uint32_t>(data + 4);
+	header.minorVersion = gfxr::Read<uint32_t>(data + 8);
+	const uint64_t numOptions = gfxr::Read<uint32_t>(data + 12);
+
+	offset = gfxr::FILE_HEADER_SIZE;
+	if (numOptions > (size - offset) / gfxr::OPTION_SIZE)
+		return fail(QString("Option list of %1 is cut short").arg(file.fileName()));
+
+	for (uint64_t i = 0; i < numOptions; i++, offset += gfxr::OPTION_SIZE) {
+		const uint32_t key = gfxr::Read<uint32_t>(data + offset);
+		const uint32_t value = gfxr::Read<uint32_t>(data + offset + 4);
+		header.options.emplace_back(key, value);
+
+		if (static_cast<gfxr::OptionKey>(key) != gfxr::OptionKey::CompressionType)
+			continue;
+		if (value > static_cast<uint32_t>(gfxr::Compression::Zstd))
+			return fail(QString("Unknown compression type %1 in %2").arg(value).arg(file.fileName()));
+		header.compression = static_cast<gfxr::Compression>(value);
+	}
+	return true;
+}
+
+void CaptureFile::indexBlocks(uint64_t offset) {
+	// Only the 12 byte headers and the first payload word are touched, the
+	// pages in between are never faulted in
+	while (size - offset >= gfxr::BLOCK_HEADER_SIZE) {
+		const uint64_t payload = gfxr::Read<uint64_t>(data + offset);
+		const uint32_t type = gfxr::Read<uint32_t>(data + offset + 8);
+		if (payload > size - offset - gfxr::BLOCK_HEADER_SIZE)
+			break;
+
+		const uint32_t id = payload >= 4 ? gfxr::Read<uint32_t>(data + offset + gfxr::BLOCK_HEADER_SIZE) : 0;
+		ownBlocks.push_back({ offset, payload, type, id });
+		if (gfxr::IsCompressed(type))
+			compressedBlocks++;
+		offset += gfxr::BLOCK_HEADER_SIZE + payload;
+	}
+
+	// A capture still being written, or one whose app was killed, ends
+	// with a partial block; everything before it is usable
+	truncated = offset != size;
+	ownBlocks.shrink_to_fit();
+	blocks = ownBlocks;
+}
+
+// Frames cover every block, so their call counts sum to the capture total
+void CaptureFile::countCalls() {
+	calls = 0;
+	for (const Frame& frame : frames)
+		calls += frame.calls;
+}
+
+void CaptureFile::indexFrames() {
+	auto isFrameEnd = [](const Block& block) {
+		return block.BaseType() == gfxr::BlockType::FrameMarker && static_cast<gfxr::MarkerType>(block.id) == gfxr::MarkerType::End;
+	};
+	const bool markers = std::any_of(blocks.begin(), blocks.end(), isFrameEnd);
+
+	Frame frame = {};
+	for (uint64_t i = 0; i < blocks.size(); i++) {
+		const Block& block = blocks[i];
+		const gfxr::BlockType type = block.BaseType();
+		frame.bytes += gfxr::BLOCK_HEADER_SIZE + block.size;
+		if (type == gfxr::BlockType::FunctionCall || type == gfxr::BlockType::MethodCall)
+			frame.calls++;
+
+		const bool end = markers ? isFrameEnd(block) : type == gfxr::BlockType::FunctionCall && block.id == gfxr::API_CALL_VK_QUEUE_PRESENT_KHR;
+		if (!end)
+			continue;
+
+		frame.endBlock = i + 1;
+		ownFrames.push_back(frame);
+		frame = { i + 1, i + 1, 0, 0 };
+	}
+
+	// Calls after the last boundary make an unfinished last frame
+	if (frame.firstBlock < blocks.size()) {
+		frame.endBlock = blocks.size();
+		ownFrames.push_back(frame);
+	}
+	ownFrames.shrink_to_fit();
+	frames = ownFrames;
+}
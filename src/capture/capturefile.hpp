@@ -0,0 +1,114 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QFile>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include <utility>
+
+#include "gfxr.hpp"
+
+class CaptureIndex;
+
+// A capture opened for viewing. The file is memory mapped and Open() only
+// walks the block headers, payloads stay in the mapping until something
+// decodes them. The index costs 24 bytes per block however large the
+// blocks are, and is split into frames at frame end markers, or at
+// vkQueuePresentKHR calls in captures without markers. A valid sidecar
+// index from an earlier open is mapped instead of walking the file again.
+class CaptureFile {
+public:
+    struct Header {
+        uint32_t majorVersion = 0;
+        uint32_t minorVersion = 0;
+        gfxr::Compression compression = gfxr::Compression::None;
+        std::vector<std::pair<uint32_t, uint32_t>> options;
+    };
+
+    struct Block {
+        uint64_t offset;
+        uint64_t size;
+        uint32_t type;
+        // API call ID, meta data ID or marker type, the first payload word
+        uint32_t id;
+
+        gfxr::BlockType BaseType() const;
+        bool IsCompressed() const;
+    };
+
+    // Blocks [firstBlock, endBlock), the frame boundary block included
+    struct Frame {
+        uint64_t firstBlock;
+        uint64_t endBlock;
+        uint64_t bytes;
+        uint64_t calls;
+    };
+
+    CaptureFile();
+    ~CaptureFile();
+    bool Open(const QString& path);
+    void Close();
+    bool IsOpen() const;
+    QString GetPath() const;
+    QString GetError() const;
+    uint64_t GetSize() const;
+    bool IsTruncated() const;
+    const Header& GetHeader() const;
+    std::span<const Block> GetBlocks() const;
+    std::span<const Frame> GetFrames() const;
+    uint64_t FindFrame(uint64_t block) const;
+    std::pair<uint64_t, uint64_t> GetFrameBlocks(uint64_t first, uint64_t end) const;
+    const uint8_t* GetPayload(const Block& block) const;
+    bool IsIndexLoaded() const;
+    uint64_t GetCallCount() const;
+    uint64_t GetCompressedBlockCount() const;
+
+private:
+    bool fail(QString error);
+    bool readHeader(uint64_t& offset);
+    void indexBlocks(uint64_t offset);
+    void indexFrames();
+    void countCalls();
+
+private:
+    QFile file;
+    const uint8_t* data;
+    uint64_t size;
+    bool truncated;
+    uint64_t calls;
+    uint64_t compressedBlocks;
+    QString error;
+    Header header;
+    std::vector<Block> ownBlocks;
+    std::vector<Frame> ownFrames;
+    std::unique_ptr<CaptureIndex> index;
+    std::span<const Block> blocks;
+    std::span<const Frame> frames;
+};
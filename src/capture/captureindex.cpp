@@ -0,0 +1,261 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "captureindex.hpp"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+#include "common.hpp"
+
+static const char MAGIC[8] = { 'G', 'F', 'X', 'R', 'I', 'D', 'X', '\0' };
+static const uint64_t SAMPLE_COUNT = 64;
+static const uint64_t SAMPLE_SIZE = 4096;
+static const size_t HASH_SIZE = 20;
+
+// Every field is naturally aligned, so the arrays after it can be used in place
+struct SidecarHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t headerSize;
+	uint64_t captureSize;
+	int64_t captureMtime;
+	uint8_t sampleHash[HASH_SIZE];
+	uint32_t truncated;
+	uint32_t majorVersion;
+	uint32_t minorVersion;
+	uint32_t compression;
+	uint32_t optionCount;
+	uint64_t blockCount;
+	uint64_t frameCount;
+	uint64_t blocksOffset;
+	uint64_t framesOffset;
+	uint64_t fileSize;
+	uint64_t compressedBlocks;
+};
+
+static_assert(sizeof(SidecarHeader) == 120);
+static_assert(sizeof(CaptureFile::Block) == 24 && std::is_trivially_copyable_v<CaptureFile::Block>);
+static_assert(sizeof(CaptureFile::Frame) == 32 && std::is_trivially_copyable_v<CaptureFile::Frame>);
+
+// Sidecars are only written and read on little endian hosts, like the captures
+static constexpr bool SUPPORTED = std::endian::native == std::endian::little;
+
+static uint64_t align8(uint64_t offset) {
+	return (offset + 7) & ~uint64_t(7);
+}
+
+// The file header plus evenly spread samples; catches a capture rewritten
+// with the same size and time without reading all of it
+static QByteArray sampleHash(const uint8_t* capture, uint64_t size) {
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(QByteArrayView(reinterpret_cast<const char*>(&size), sizeof(size)));
+	const uint64_t sample = std::min(SAMPLE_SIZE, size);
+	for (uint64_t i = 0; i < SAMPLE_COUNT; i++) {
+		const uint64_t offset = (size - sample) / (SAMPLE_COUNT - 1) * i;
+		hash.addData(QByteArrayView(reinterpret_cast<const char*>(capture + offset), sample));
+	}
+	return hash.result();
+}
+
+// One pass over the mapped arrays, so a damaged sidecar never points
+// readers outside the capture or past the block array
+static bool validArrays(std::span<const CaptureFile::Block> blocks, std::span<const CaptureFile::Frame> frames, uint64_t captureSize) {
+	uint64_t next = 0;
+	for (const CaptureFile::Block& block : blocks) {
+		if (block.offset < next || block.offset > captureSize || captureSize - block.offset < gfxr::BLOCK_HEADER_SIZE
+			|| block.size > captureSize - block.offset - gfxr::BLOCK_HEADER_SIZE)
+			return false;
+		next = block.offset + gfxr::BLOCK_HEADER_SIZE + block.size;
+	}
+
+	// Frames cover the blocks back to back
+	uint64_t first = 0;
+	for (const CaptureFile::Frame& frame : frames) {
+		if (frame.firstBlock != first || frame.endBlock <= frame.firstBlock || frame.endBlock > blocks.size())
+			return false;
+		first = frame.endBlock;
+	}
+	return first == blocks.size();
+}
+
+CaptureIndex::CaptureIndex()
+	: data(nullptr), truncated(false), compressedBlocks(0)
+{
+}
+
+CaptureIndex::~CaptureIndex() {
+	close();
+}
+
+std::span<const CaptureFile::Block> CaptureIndex::GetBlocks() const {
+	return blocks;
+}
+
+std::span<const CaptureFile::Frame> CaptureIndex::GetFrames() const {
+	return frames;
+}
+
+bool CaptureIndex::IsTruncated() const {
+	return truncated;
+}
+
+uint64_t CaptureIndex::GetCompressedBlockCount() const {
+	return compressedBlocks;
+}
+
+void CaptureIndex::close() {
+	if (data)
+		file.unmap(const_cast<uint8_t*>(data));
+	file.close();
+	data = nullptr;
+	blocks = {};
+	frames = {};
+	truncated = false;
+	compressedBlocks = 0;
+}
+
+QStringList CaptureIndex::Candidates(const QString& capturePath) {
+	const QByteArray key = QCryptographicHash::hash(QFileInfo(capturePath).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+	QDir cache(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
+	return { capturePath + ".idx", cache.filePath(QString("index/%1.idx").arg(QString::fromLatin1(key))) };
+}
+
+bool CaptureIndex::Load(const QString& capturePath, const uint8_t* capture, uint64_t size, qint64 mtime, const CaptureFile::Header& header) {
+	if (!SUPPORTED)
+		return false;
+	for (const QString& path : Candidates(capturePath)) {
+		if (load(path, capture, size, mtime, header))
+			return true;
+	}
+	return false;
+}
+
+bool CaptureIndex::load(const QString& path, const uint8_t* capture, uint64_t size, qint64 mtime, const CaptureFile::Header& header) {
+	close();
+	file.setFileName(path);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	const uint64_t fileSize = file.size();
+	if (fileSize < sizeof(SidecarHeader))
+		return false;
+	data = file.map(0, fileSize);
+	if (!data)
+		return false;
+
+	SidecarHeader sidecar;
+	memcpy(&sidecar, data, sizeof(sidecar));
+	const bool layoutValid = memcmp(sidecar.magic, MAGIC, sizeof(MAGIC)) == 0
+		&& sidecar.version == VERSION
+		&& sidecar.headerSize == sizeof(SidecarHeader)
+		&& sidecar.fileSize == fileSize
+		&& sidecar.blocksOffset >= sizeof(SidecarHeader) && sidecar.framesOffset <= fileSize
+		&& sidecar.blocksOffset % 8 == 0 && sidecar.framesOffset % 8 == 0
+		&& sidecar.blockCount <= (fileSize - sidecar.blocksOffset) / sizeof(CaptureFile::Block)
+		&& sidecar.framesOffset >= sidecar.blocksOffset + sidecar.blockCount * sizeof(CaptureFile::Block)
+		&& sidecar.frameCount <= (fileSize - std::min(fileSize, sidecar.framesOffset)) / sizeof(CaptureFile::Frame);
+	if (!layoutValid) {
+		LOGD("Ignoring sidecar %s, unknown version or damaged", path.toStdString().c_str());
+		close();
+		return false;
+	}
+
+	const bool matches = sidecar.captureSize == size
+		&& sidecar.captureMtime == mtime
+		&& sidecar.majorVersion == header.majorVersion
+		&& sidecar.minorVersion == header.minorVersion
+		&& sidecar.compression == static_cast<uint32_t>(header.compression)
+		&& sidecar.optionCount == header.options.size()
+		&& sampleHash(capture, size) == QByteArray(reinterpret_cast<const char*>(sidecar.sampleHash), HASH_SIZE);
+	if (!matches) {
+		LOGD("Sidecar %s is stale", path.toStdString().c_str());
+		close();
+		return false;
+	}
+
+	blocks = { reinterpret_cast<const CaptureFile::Block*>(data + sidecar.blocksOffset), sidecar.blockCount };
+	frames = { reinterpret_cast<const CaptureFile::Frame*>(data + sidecar.framesOffset), sidecar.frameCount };
+	if (!validArrays(blocks, frames, size)) {
+		LOGD("Ignoring sidecar %s, damaged index", path.toStdString().c_str());
+		close();
+		return false;
+	}
+	truncated = sidecar.truncated != 0;
+	compressedBlocks = sidecar.compressedBlocks;
+	return true;
+}
+
+bool CaptureIndex::Save(const QString& capturePath, const uint8_t* capture, uint64_t size, qint64 mtime, const CaptureFile::Header& header,
+	std::span<const CaptureFile::Block> blocks, std::span<const CaptureFile::Frame> frames, bool truncated, uint64_t compressedBlocks) {
+	if (!SUPPORTED)
+		return false;
+
+	SidecarHeader sidecar = {};
+	memcpy(sidecar.magic, MAGIC, sizeof(MAGIC));
+	sidecar.version = VERSION;
+	sidecar.headerSize = sizeof(SidecarHeader);
+	sidecar.captureSize = size;
+	sidecar.captureMtime = mtime;
+	memcpy(sidecar.sampleHash, sampleHash(capture, size).constData(), HASH_SIZE);
+	sidecar.truncated = truncated;
+	sidecar.majorVersion = header.majorVersion;
+	sidecar.minorVersion = header.minorVersion;
+	sidecar.compression = static_cast<uint32_t>(header.compression);
+	sidecar.optionCount = static_cast<uint32_t>(header.options.size());
+	sidecar.blockCount = blocks.size();
+	sidecar.frameCount = frames.size();
+	sidecar.blocksOffset = align8(sizeof(SidecarHeader));
+	sidecar.framesOffset = align8(sidecar.blocksOffset + blocks.size_bytes());
+	sidecar.fileSize = sidecar.framesOffset + frames.size_bytes();
+	sidecar.compressedBlocks = compressedBlocks;
+
+	for (const QString& path : Candidates(capturePath)) {
+		QDir().mkpath(QFileInfo(path).absolutePath());
+		QSaveFile f(path);
+		if (!f.open(QIODevice::WriteOnly))
+			continue;
+
+		const char padding[8] = {};
+		f.write(reinterpret_cast<const char*>(&sidecar), sizeof(sidecar));
+		f.write(padding, sidecar.blocksOffset - sizeof(sidecar));
+		f.write(reinterpret_cast<const char*>(blocks.data()), blocks.size_bytes());
+		f.write(padding, sidecar.framesOffset - sidecar.blocksOffset - blocks.size_bytes());
+		f.write(reinterpret_cast<const char*>(frames.data()), frames.size_bytes());
+		if (f.commit()) {
+			LOGD("Wrote sidecar %s", path.toStdString().c_str());
+			return true;
+		}
+	}
+
+	LOGD("Cannot write a sidecar for %s", capturePath.toStdString().c_str());
+	return false;
+}
@@ -0,0 +1,69 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QFile>
+#include <QStringList>
+
+#include <cstdint>
+#include <span>
+
+#include "capturefile.hpp"
+
+// Versioned binary sidecar holding a capture's block and frame index,
+// written as <capture>.idx next to the capture, or in the app data
+// directory when that is read only. It is tied to the capture by size,
+// modification time and a hash of sampled ranges, and on a match the
+// arrays are used straight from the mapped file.
+class CaptureIndex {
+public:
+    // Bump whenever the header, Block or Frame layout changes
+    static constexpr uint32_t VERSION = 2;
+
+    CaptureIndex();
+    ~CaptureIndex();
+    bool Load(const QString& capturePath, const uint8_t* capture, uint64_t size, qint64 mtime, const CaptureFile::Header& header);
+    std::span<const CaptureFile::Block> GetBlocks() const;
+    std::span<const CaptureFile::Frame> GetFrames() const;
+    bool IsTruncated() const;
+    uint64_t GetCompressedBlockCount() const;
+
+    static bool Save(const QString& capturePath, const uint8_t* capture, uint64_t size, qint64 mtime, const CaptureFile::Header& header,
+        std::span<const CaptureFile::Block> blocks, std::span<const CaptureFile::Frame> frames, bool truncated, uint64_t compressedBlocks);
+    static QStringList Candidates(const QString& capturePath);
+
+private:
+    bool load(const QString& path, const uint8_t* capture, uint64_t size, qint64 mtime, const CaptureFile::Header& header);
+    void close();
+
+private:
+    QFile file;
+    const uint8_t* data;
+    std::span<const CaptureFile::Block> blocks;
+    std::span<const CaptureFile::Frame> frames;
+    bool truncated;
+    uint64_t compressedBlocks;
+};
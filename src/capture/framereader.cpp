@@ -0,0 +1,85 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "framereader.hpp"
+
+#include <algorithm>
+
+#include "common.hpp"
+
+FrameReader::FrameReader(const CaptureFile& capture, int workers)
+	: capture(capture), decompressor(capture, workers)
+{
+}
+
+FrameReader::~FrameReader() {
+}
+
+bool FrameReader::Read(uint64_t first, uint64_t end, Sink sink) {
+	const auto [begin, last] = capture.GetFrameBlocks(first, end);
+	return ReadBlocks(begin, last, std::move(sink));
+}
+
+// Any block range, e.g. a frame read in pieces
+bool FrameReader::ReadBlocks(uint64_t begin, uint64_t end, Sink sink) {
+	const std::span<const CaptureFile::Block> blocks = capture.GetBlocks();
+	const std::span<const CaptureFile::Frame> frames = capture.GetFrames();
+	end = std::min<uint64_t>(end, blocks.size());
+	if (begin >= end)
+		return true;
+
+	uint64_t frame = capture.FindFrame(begin);
+	return decompressor.Decompress(begin, end, [&](const BlockDecompressor::Result& result) {
+		while (frame < frames.size() && result.index >= frames[frame].endBlock)
+			frame++;
+
+		Call call;
+		if (!makeCall(result, frame, call))
+			return true;
+		return sink(call);
+	});
+}
+
+bool FrameReader::makeCall(const BlockDecompressor::Result& result, uint64_t frame, Call& call) const {
+	const CaptureFile::Block& block = capture.GetBlocks()[result.index];
+	const gfxr::BlockType type = block.BaseType();
+	if (type != gfxr::BlockType::FunctionCall && type != gfxr::BlockType::MethodCall)
+		return false;
+
+	// The call prefix is never compressed, read it from the mapping
+	const uint8_t* payload = capture.GetPayload(block);
+	const bool method = type == gfxr::BlockType::MethodCall;
+	call = Call();
+	call.frame = frame;
+	call.block = result.index;
+	call.id = block.id;
+	call.ok = result.ok;
+	if (result.ok) {
+		call.object = method ? gfxr::Read<uint64_t>(payload + 4) : 0;
+		call.thread = gfxr::Read<uint64_t>(payload + (method ? 12 : 4));
+		call.params = result.data;
+		call.paramSize = result.size;
+	}
+	return true;
+}
@@ -0,0 +1,64 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "capturefile.hpp"
+#include "blockdecompressor.hpp"
+
+// Random access to the calls of any frame range. The block range comes
+// from the frame index, so seeking to a frame costs the same wherever it
+// is, and only the blocks of that range are decompressed.
+class FrameReader {
+public:
+    struct Call {
+        uint64_t frame = 0;
+        uint64_t block = 0;
+        uint32_t id = 0;
+        uint64_t thread = 0;
+        // Zero for function calls
+        uint64_t object = 0;
+        const uint8_t* params = nullptr;
+        uint64_t paramSize = 0;
+        bool ok = false;
+    };
+
+    // Return false to stop early; params are only valid during the call
+    using Sink = std::function<bool(const Call& call)>;
+
+    FrameReader(const CaptureFile& capture, int workers = 0);
+    ~FrameReader();
+    bool Read(uint64_t first, uint64_t end, Sink sink);
+    bool ReadBlocks(uint64_t begin, uint64_t end, Sink sink);
+
+private:
+    bool makeCall(const BlockDecompressor::Result& result, uint64_t frame, Call& call) const;
+
+private:
+    const CaptureFile& capture;
+    BlockDecompressor decompressor;
+};
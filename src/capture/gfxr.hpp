@@ -0,0 +1,97 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// On-disk layout of GFXReconstruct capture files. All fields are little endian
+// and structures are tightly packed, so they are decoded field by field.
+namespace gfxr {
+
+constexpr uint32_t FOURCC = 'G' | ('F' << 8) | ('X' << 16) | ('R' << 24);
+constexpr uint32_t COMPRESSED_BLOCK_BIT = 0x80000000u;
+
+constexpr uint64_t FILE_HEADER_SIZE = 16;
+constexpr uint64_t OPTION_SIZE = 8;
+constexpr uint64_t BLOCK_HEADER_SIZE = 12;
+
+// Call payloads start with uint32 API call ID and uint64 thread ID, method
+// calls have a uint64 object ID in between. Compressed calls then carry the
+// uint64 uncompressed size, and the parameter data follows.
+constexpr uint64_t FUNCTION_CALL_PREFIX = 12;
+constexpr uint64_t METHOD_CALL_PREFIX = 20;
+constexpr uint64_t UNCOMPRESSED_SIZE_FIELD = 8;
+
+// API call IDs carry the API family in the upper 16 bits, Vulkan is 1
+constexpr uint32_t API_CALL_VK_QUEUE_SUBMIT = 0x00011012;
+constexpr uint32_t API_CALL_VK_BEGIN_COMMAND_BUFFER = 0x0001105a;
+constexpr uint32_t API_CALL_VK_END_COMMAND_BUFFER = 0x0001105b;
+constexpr uint32_t API_CALL_VK_QUEUE_PRESENT_KHR = 0x00011092;
+
+enum class BlockType : uint32_t {
+    Unknown = 0,
+    FrameMarker = 1,
+    StateMarker = 2,
+    MetaData = 3,
+    FunctionCall = 4,
+    Annotation = 5,
+    MethodCall = 6,
+};
+
+enum class MarkerType : uint32_t {
+    Unknown = 0,
+    Begin = 1,
+    End = 2,
+};
+
+enum class OptionKey : uint32_t {
+    Unknown = 0,
+    CompressionType = 1,
+};
+
+enum class Compression : uint32_t {
+    None = 0,
+    Lz4 = 1,
+    Zlib = 2,
+    Zstd = 3,
+};
+
+inline BlockType BaseType(uint32_t type) {
+    return static_cast<BlockType>(type & ~COMPRESSED_BLOCK_BIT);
+}
+
+inline bool IsCompressed(uint32_t type) {
+    return (type & COMPRESSED_BLOCK_BIT) != 0;
+}
+
+template<typename T>
+inline T Read(const void* data) {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+}
\ No newline at end of file
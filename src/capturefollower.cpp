@@ -0,0 +1,135 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "capturefollower.hpp"
+
+#include <algorithm>
+#include <limits>
+#include "common.hpp"
+
+// Bytes per second allowed for following, adjusted additively up and
+// multiplicatively down
+static const double MIN_BUDGET = 1 << 20;
+static const double MAX_BUDGET = 64 << 20;
+static const double BUDGET_STEP = 1 << 20;
+
+CaptureFollower::CaptureFollower(std::string serial, QString remote, QString local)
+	: serial(serial), remote(remote), local(local), sync(serial), stream(serial),
+	offset(0), budget(8 << 20), baselineLatency(0.0)
+{
+	this->local.open(QIODevice::WriteOnly | QIODevice::Truncate);
+	sincePoll.start();
+}
+
+CaptureFollower::~CaptureFollower() {
+}
+
+const BlockParser::Stats& CaptureFollower::GetStats() const {
+	return parser.GetStats();
+}
+
+CaptureFollower::Progress CaptureFollower::GetProgress() const {
+	return { parser.GetStats(), offset, budget };
+}
+
+qint64 CaptureFollower::GetOffset() const {
+	return offset;
+}
+
+double CaptureFollower::GetBudget() const {
+	return budget;
+}
+
+QString CaptureFollower::GetLocalPath() const {
+	return local.fileName();
+}
+
+bool CaptureFollower::IsOpen() const {
+	return local.isOpen();
+}
+
+QString CaptureFollower::GetError() const {
+	return local.errorString();
+}
+
+bool CaptureFollower::pull(qint64 limit) {
+	AdbSync::RemoteStat stat;
+	QElapsedTimer latency;
+	latency.start();
+	if (!sync.Stat(remote, stat)) {
+		sync.Close();
+		return false;
+	}
+	const double elapsed = latency.nsecsElapsed() / 1e6;
+
+	// A slower stat than usual means the device or link is busy, back off
+	if (baselineLatency == 0.0 || elapsed < baselineLatency)
+		baselineLatency = elapsed;
+	if (elapsed > baselineLatency * 3 + 5)
+		budget = std::max(MIN_BUDGET, budget / 2);
+	else
+		budget = std::min(MAX_BUDGET, budget + BUDGET_STEP);
+
+	if (!stat.exists)
+		return true;
+
+	if (static_cast<qint64>(stat.size) < offset) {
+		LOGD("%s shrank, capture restarted, following from the start", remote.toStdString().c_str());
+		if (!local.resize(0) || !local.seek(0))
+			return false;
+		offset = 0;
+		parser = BlockParser();
+	}
+
+	const qint64 length = std::min<qint64>(stat.size - offset, limit);
+	if (length <= 0)
+		return true;
+
+	return stream.ReadRange(remote, offset, length, [&](const char* data, qint64 size) {
+		if (local.write(data, size) != size)
+			return false;
+		parser.Feed(data, size);
+		offset += size;
+		return true;
+	}) == AdbStream::Result::Done;
+}
+
+bool CaptureFollower::Poll() {
+	if (!local.isOpen())
+		return false;
+
+	const qint64 limit = static_cast<qint64>(budget * std::max(sincePoll.restart() / 1000.0, 0.1));
+	return pull(limit);
+}
+
+bool CaptureFollower::Finish() {
+	if (!local.isOpen())
+		return false;
+
+	// The app is stopped, drain whatever is left without a budget
+	bool result = pull(std::numeric_limits<qint64>::max());
+	local.close();
+	LOGD("Followed %lld bytes of %s into %s", offset, remote.toStdString().c_str(), local.fileName().toStdString().c_str());
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QFile>
+#include <QElapsedTimer>
+
+#include <string>
+
+#include "adbsync.hpp"
+#include "adbstream.hpp"
+#include "blockparser.hpp"
+
+// Follows a capture file while the app is still recording it. Each Poll()
+// pulls only the bytes appended since the last one into a local copy and
+// feeds them to a BlockParser for live stats. The per-poll byte budget
+// backs off when device round trips slow down, so following does not
+// compete with the app being captured. When the remote file shrinks the app
+// has restarted the capture, and following starts over from its beginning.
+class CaptureFollower {
+public:
+    struct Progress {
+        BlockParser::Stats stats;
+        qint64 offset = 0;
+        double budget = 0.0;
+    };
+
+    CaptureFollower(std::string serial, QString remote, QString local);
+    ~CaptureFollower();
+    bool IsOpen() const;
+    bool Poll();
+    bool Finish();
+    const BlockParser::Stats& GetStats() const;
+    Progress GetProgress() const;
+    qint64 GetOffset() const;
+    double GetBudget() const;
+    QString GetLocalPath() const;
+    QString GetError() const;
+
+private:
+    bool pull(qint64 limit);
+
+private:
+    std::string serial;
+    QString remote;
+    QFile local;
+    AdbSync sync;
+    AdbStream stream;
+    BlockParser parser;
+    QElapsedTimer sincePoll;
+    qint64 offset;
+    double budget;
+    double baselineLatency;
+};
\ No newline at end of file
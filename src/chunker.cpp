@@ -0,0 +1,89 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "chunker.hpp"
+
+#include <QFile>
+#include <QCryptographicHash>
+
+#include <array>
+
+static const qint64 READ_SIZE = 4 << 20;
+
+static const std::array<quint64, 256> gearTable = [] {
+	// splitmix64 with a fixed seed, boundaries must be stable across runs
+	std::array<quint64, 256> table{};
+	quint64 state = 0;
+	for (quint64& value : table) {
+		state += 0x9E3779B97F4A7C15ull;
+		quint64 z = state;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		value = z ^ (z >> 31);
+	}
+	return table;
+}();
+
+bool Chunker::Split(QFile& file, std::vector<Chunk>& chunks) {
+	if (!file.seek(0))
+		return false;
+
+	chunks.clear();
+	QByteArray buf(READ_SIZE, Qt::Uninitialized);
+	QCryptographicHash sha1(QCryptographicHash::Sha1);
+	quint64 hash = 0;
+	qint64 chunkStart = 0;
+	qint64 pos = 0;
+
+	while (true) {
+		const qint64 n = file.read(buf.data(), buf.size());
+		if (n < 0)
+			return false;
+		if (n == 0)
+			break;
+
+		const uchar* data = reinterpret_cast<const uchar*>(buf.constData());
+		qint64 segmentStart = 0;
+		for (qint64 i = 0; i < n; i++) {
+			hash = (hash << 1) + gearTable[data[i]];
+			const qint64 length = pos + i + 1 - chunkStart;
+			if ((length >= MIN_SIZE && (hash & MASK) == 0) || length >= MAX_SIZE) {
+				sha1.addData(QByteArrayView(buf.constData() + segmentStart, i + 1 - segmentStart));
+				chunks.push_back({ chunkStart, length, sha1.result().toHex() });
+				sha1.reset();
+				hash = 0;
+				chunkStart = pos + i + 1;
+				segmentStart = i + 1;
+			}
+		}
+
+		sha1.addData(QByteArrayView(buf.constData() + segmentStart, n - segmentStart));
+		pos += n;
+	}
+
+	if (pos > chunkStart)
+		chunks.push_back({ chunkStart, pos - chunkStart, sha1.result().toHex() });
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+
+#include <vector>
+
+class QFile;
+
+// Content-defined chunking with a gear rolling hash (FastCDC style). Chunk
+// boundaries depend only on the 64 bytes before them, so after an edit,
+// insertion or cut the boundaries fall back into step within a chunk or two
+// and the chunks past it keep their hashes, only at other offsets. No chunk
+// is shorter than MIN_SIZE; past it a boundary comes with probability
+// 1/(MASK+1) per byte, about 3 MiB per chunk on average. Each chunk carries
+// the hex SHA-1 of its bytes so it can be compared against "sha1sum" output
+// from the device.
+class Chunker {
+public:
+    struct Chunk {
+        qint64 offset;
+        qint64 length;
+        QByteArray hash;
+    };
+
+    static const qint64 MIN_SIZE = 1 << 20;
+    static const qint64 MAX_SIZE = 16 << 20;
+    static const quint64 MASK = (1ull << 21) - 1;
+
+    static bool Split(QFile& file, std::vector<Chunk>& chunks);
+};
\ No newline at end of file
@@ -0,0 +1,184 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "compressedpush.hpp"
+
+#include <QFile>
+#include <QTcpSocket>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QtEndian>
+
+#include <deque>
+#include <future>
+#include <array>
+#include <algorithm>
+#include "adbclient.hpp"
+#include "adbshell.hpp"
+#include "common.hpp"
+
+static const qint64 BLOCK_SIZE = 4 << 20;
+static const qint64 PROBE_SIZE = 32 << 20;
+static const qint64 WRITE_LIMIT = 8 << 20;
+// Worse than this compressed/raw ratio is not worth the CPU
+static const double MAX_RATIO = 0.9;
+
+static quint32 crc32(const QByteArray& data) {
+	static const std::array<quint32, 256> table = [] {
+		std::array<quint32, 256> t{};
+		for (quint32 i = 0; i < 256; i++) {
+			quint32 c = i;
+			for (int k = 0; k < 8; k++)
+				c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			t[i] = c;
+		}
+		return t;
+	}();
+
+	quint32 crc = 0xFFFFFFFFu;
+	for (char byte : data)
+		crc = table[(crc ^ static_cast<uchar>(byte)) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFFu;
+}
+
+QByteArray CompressedPush::GzipMember(const QByteArray& data, int level) {
+	// qCompress emits a 4-byte length, a 2-byte zlib header, the raw deflate
+	// stream and a 4-byte adler32. Re-wrap the deflate stream as a gzip member.
+	const QByteArray zlib = qCompress(data, level);
+	if (data.isEmpty() || zlib.size() < 10)
+		return QByteArray();
+
+	static const char header[10] = { '\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff' };
+	char trailer[8];
+	qToLittleEndian<quint32>(crc32(data), trailer);
+	qToLittleEndian<quint32>(static_cast<quint32>(data.size()), trailer + 4);
+
+	QByteArray member;
+	member.reserve(sizeof(header) + zlib.size() - 6 + sizeof(trailer));
+	member.append(header, sizeof(header));
+	member.append(zlib.constData() + 6, zlib.size() - 10);
+	member.append(trailer, sizeof(trailer));
+	return member;
+}
+
+CompressedPush::CompressedPush(std::string serial, int level)
+	: serial(serial), level(level), ratio(1.0), throughput(0.0)
+{
+}
+
+CompressedPush::~CompressedPush() {
+}
+
+double CompressedPush::Ratio() const {
+	return ratio;
+}
+
+double CompressedPush::Throughput() const {
+	return throughput;
+}
+
+CompressedPush::Result CompressedPush::Push(QFile& src, QString dst, double rawThroughput, Progress progress) {
+	auto socket = AdbClient().OpenService(serial, QString("shell,v2,raw:gzip -d > %1").arg(AdbShell::Quote(dst)));
+	if (!socket) {
+		LOGD("Failed to start gzip on %s", serial.c_str());
+		return Result::Failed;
+	}
+
+	const qint64 totalSize = src.size();
+	const size_t maxInflight = std::max(1, QThread::idealThreadCount()) * 2;
+	std::deque<std::future<QByteArray>> inflight;
+	std::deque<qint64> inflightSize;
+
+	QElapsedTimer timer;
+	timer.start();
+	qint64 rawSent = 0;
+	qint64 wireSent = 0;
+	bool eof = false;
+	bool probed = false;
+
+	while (!eof || !inflight.empty()) {
+		while (!eof && inflight.size() < maxInflight) {
+			QByteArray block = src.read(BLOCK_SIZE);
+			if (block.isEmpty()) {
+				eof = true;
+				break;
+			}
+			inflightSize.push_back(block.size());
+			inflight.push_back(std::async(std::launch::async, [block, level = level] {
+				return GzipMember(block, level);
+			}));
+		}
+
+		if (inflight.empty())
+			break;
+
+		// Members are written in submission order, so the stream stays ordered
+		const QByteArray member = inflight.front().get();
+		const qint64 rawSize = inflightSize.front();
+		inflight.pop_front();
+		inflightSize.pop_front();
+
+		if (member.isEmpty() || !AdbClient::WriteShellPacket(*socket, AdbClient::ShellStdin, member))
+			return Result::Failed;
+		while (socket->bytesToWrite() > WRITE_LIMIT) {
+			if (!socket->waitForBytesWritten(-1))
+				return Result::Failed;
+		}
+
+		rawSent += rawSize;
+		wireSent += member.size();
+		ratio = static_cast<double>(wireSent) / rawSent;
+		throughput = rawSent / std::max(timer.elapsed() / 1000.0, 0.001);
+		if (progress && !progress(rawSent, totalSize)) {
+			socket->abort();
+			return Result::Failed;
+		}
+
+		if (!probed && rawSent >= PROBE_SIZE && rawSent < totalSize) {
+			probed = true;
+			LOGD("Compressed push ratio %.2f, %.1f MB/s effective, raw %.1f MB/s",
+				ratio, throughput / 1e6, rawThroughput / 1e6);
+			if (ratio > MAX_RATIO || (rawThroughput > 0 && throughput < rawThroughput)) {
+				socket->abort();
+				return Result::NotWorthwhile;
+			}
+		}
+	}
+
+	if (!AdbClient::WriteShellPacket(*socket, AdbClient::ShellCloseStdin, QByteArray()))
+		return Result::Failed;
+
+	char id;
+	QByteArray data;
+	while (AdbClient::ReadShellPacket(*socket, id, data)) {
+		if (id == AdbClient::ShellStderr)
+			LOGD("gzip: %s", data.constData());
+		if (id == AdbClient::ShellExit) {
+			throughput = rawSent / std::max(timer.elapsed() / 1000.0, 0.001);
+			LOGD("Compressed push of %lld bytes as %lld, %.1f MB/s", rawSent, wireSent, throughput / 1e6);
+			return !data.isEmpty() && data[0] == 0 ? Result::Done : Result::Failed;
+		}
+	}
+	return Result::Failed;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+
+#include <string>
+#include <functional>
+
+class QFile;
+
+// Streams a file to the device as concatenated gzip members compressed on
+// all host cores, decompressed on the fly by the device's "gzip -d" through
+// an adb shell v2 session. After a probe window it compares the effective
+// transfer rate against the last known raw sync rate and gives up early when
+// compression does not pay off, so the caller can fall back to a raw push.
+class CompressedPush {
+public:
+    enum class Result {
+        Done,
+        Failed,
+        NotWorthwhile,
+    };
+
+    // Returns false to abort the transfer
+    using Progress = std::function<bool(qint64 done, qint64 total)>;
+
+    CompressedPush(std::string serial, int level = 3);
+    ~CompressedPush();
+    Result Push(QFile& src, QString dst, double rawThroughput, Progress progress = nullptr);
+    double Ratio() const;
+    double Throughput() const;
+
+    static QByteArray GzipMember(const QByteArray& data, int level);
+
+private:
+    std::string serial;
+    int level;
+    double ratio;
+    double throughput;
+};
\ No newline at end of file
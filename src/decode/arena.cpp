@@ -0,0 +1,107 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "arena.hpp"
+
+Arena::Arena(size_t chunkSize)
+	: chunkSize(chunkSize), current(0), cursor(nullptr), limit(nullptr), used(0)
+{
+}
+
+Arena::~Arena() {
+}
+
+static uint8_t* alignUp(uint8_t* pointer, size_t align) {
+	const uintptr_t value = reinterpret_cast<uintptr_t>(pointer);
+	return reinterpret_cast<uint8_t*>((value + align - 1) & ~(uintptr_t(align) - 1));
+}
+
+void* Arena::Allocate(size_t size, size_t align) {
+	uint8_t* start = cursor ? alignUp(cursor, align) : nullptr;
+	if (!start || size > static_cast<size_t>(limit - start)) {
+		// Big records get a chunk of their own instead of wasting the rest of this one
+		if (size > chunkSize / 4)
+			return allocateLarge(size, align);
+
+		// Move on to the next chunk, reusing the ones kept by Reset()
+		if (cursor)
+			current++;
+		while (current < chunks.size() && chunks[current].large)
+			current++;
+		if (current == chunks.size())
+			chunks.push_back({ std::unique_ptr<uint8_t[]>(new uint8_t[chunkSize]), chunkSize, false });
+		cursor = chunks[current].data.get();
+		limit = cursor + chunkSize;
+		start = alignUp(cursor, align);
+	}
+
+	cursor = start + size;
+	used += size;
+	return start;
+}
+
+void* Arena::allocateLarge(size_t size, size_t align) {
+	Chunk chunk = { std::unique_ptr<uint8_t[]>(new uint8_t[size + align]), size + align, true };
+	void* start = alignUp(chunk.data.get(), align);
+	// Keep it out of the way of the chunk being filled
+	chunks.insert(chunks.begin() + (cursor ? current : chunks.size()), std::move(chunk));
+	if (cursor)
+		current++;
+	used += size;
+	return start;
+}
+
+std::string_view Arena::Copy(std::string_view text) {
+	if (text.empty())
+		return {};
+	char* copy = static_cast<char*>(Allocate(text.size(), 1));
+	memcpy(copy, text.data(), text.size());
+	return { copy, text.size() };
+}
+
+// Large chunks go back to the heap, standard ones are kept for reuse
+void Arena::Reset() {
+	std::erase_if(chunks, [](const Chunk& chunk) {
+		return chunk.large;
+	});
+	current = 0;
+	cursor = nullptr;
+	limit = nullptr;
+	used = 0;
+}
+
+size_t Arena::GetBytesUsed() const {
+	return used;
+}
+
+size_t Arena::GetBytesReserved() const {
+	size_t reserved = 0;
+	for (const Chunk& chunk : chunks)
+		reserved += chunk.size;
+	return reserved;
+}
+
+size_t Arena::GetChunkCount() const {
+	return chunks.size();
+}
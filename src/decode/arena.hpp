@@ -0,0 +1,91 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Monotonic bump allocator for decoded data that lives and dies together,
+// e.g. every call decoded for one frame. Allocating is a pointer bump in
+// the current chunk and nothing is freed on its own; Reset() rewinds and
+// keeps the chunks for the next batch, destroying the arena frees them all
+// at once. Destructors never run, so only trivially destructible types.
+class Arena {
+public:
+    static constexpr size_t CHUNK_SIZE = 64 << 10;
+
+    Arena(size_t chunkSize = CHUNK_SIZE);
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(size_t size, size_t align = alignof(std::max_align_t));
+    std::string_view Copy(std::string_view text);
+    void Reset();
+    size_t GetBytesUsed() const;
+    size_t GetBytesReserved() const;
+    size_t GetChunkCount() const;
+
+    template<typename T, typename... Args>
+    T* New(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    T* NewArray(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "Arena arrays are copied bytewise");
+        if (!count)
+            return nullptr;
+        T* array = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        memcpy(array, values, sizeof(T) * count);
+        return array;
+    }
+
+private:
+    struct Chunk {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+        bool large;
+    };
+
+    void* allocateLarge(size_t size, size_t align);
+
+private:
+    size_t chunkSize;
+    std::vector<Chunk> chunks;
+    // Chunks before this one are full
+    size_t current;
+    uint8_t* cursor;
+    uint8_t* limit;
+    size_t used;
+};
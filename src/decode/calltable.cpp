@@ -0,0 +1,607 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "calltable.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <map>
+
+#if defined(__x86_64__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+#define CALLTABLE_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+#endif
+
+namespace vkdecode {
+
+// Conditions the vector kernels keep in registers, more go the scalar way
+static constexpr size_t MAX_CONDITIONS = 8;
+// IDs spread wider than this are searched for instead
+static constexpr uint32_t MAX_BITMAP_IDS = 1 << 24;
+
+CallTable::CallTable() {
+}
+
+CallTable::~CallTable() {
+}
+
+void CallTable::Reserve(size_t rows) {
+	ids.reserve(rows);
+	frames.reserve(rows);
+	threads.reserve(rows);
+	blocks.reserve(rows);
+	for (std::vector<uint32_t>& column : params)
+		column.reserve(rows);
+}
+
+// Rows must come in block order, Filter() relies on frames being sorted
+void CallTable::Append(uint32_t id, uint32_t frame, uint64_t thread, uint32_t block, const Value* values, size_t count) {
+	auto [it, added] = threadIndex.try_emplace(thread, static_cast<uint32_t>(threadIds.size()));
+	if (added)
+		threadIds.push_back(thread);
+
+	ids.push_back(id);
+	frames.push_back(frame);
+	threads.push_back(it->second);
+	blocks.push_back(block);
+	for (size_t i = 0; i < HOT_PARAMS; i++)
+		params[i].push_back(i + 1 < count ? static_cast<uint32_t>(values[i + 1].bits) : 0);
+}
+
+size_t CallTable::GetRowCount() const {
+	return ids.size();
+}
+
+std::span<const uint32_t> CallTable::GetIds() const {
+	return ids;
+}
+
+std::span<const uint32_t> CallTable::GetFrames() const {
+	return frames;
+}
+
+std::span<const uint32_t> CallTable::GetBlocks() const {
+	return blocks;
+}
+
+uint64_t CallTable::GetThread(size_t row) const {
+	return threadIds[threads[row]];
+}
+
+size_t CallTable::GetBytes() const {
+	return ids.capacity() * sizeof(uint32_t) * (4 + HOT_PARAMS) + threadIds.capacity() * sizeof(uint64_t);
+}
+
+namespace {
+
+struct Test {
+	const uint32_t* column;
+	CallTable::Op op;
+	uint32_t value;
+};
+
+// A query resolved against the columns
+struct Plan {
+	const uint32_t* ids = nullptr;
+	const uint32_t* threads = nullptr;
+	bool anyId = true;
+	// Sorted
+	std::vector<uint32_t> idList;
+	// For lists too long to compare one by one
+	std::vector<uint32_t> idBits;
+	uint32_t idBase = 0;
+	uint32_t idSpan = 0;
+	bool anyThread = true;
+	uint32_t thread = 0;
+	std::vector<Test> tests;
+};
+
+}
+
+static bool compare(uint32_t value, CallTable::Op op, uint32_t operand) {
+	switch (op) {
+	case CallTable::Op::Eq:
+		return value == operand;
+	case CallTable::Op::Ne:
+		return value != operand;
+	case CallTable::Op::Lt:
+		return value < operand;
+	case CallTable::Op::Le:
+		return value <= operand;
+	case CallTable::Op::Gt:
+		return value > operand;
+	case CallTable::Op::Ge:
+		return value >= operand;
+	}
+	return false;
+}
+
+static bool matchRow(const Plan& plan, size_t row) {
+	if (!plan.anyThread && plan.threads[row] != plan.thread)
+		return false;
+	if (!plan.anyId) {
+		const uint32_t id = plan.ids[row];
+		if (!plan.idBits.empty()) {
+			// IDs below the base wrap around past the end
+			const uint32_t slot = id - plan.idBase;
+			if (slot >= plan.idSpan || !(plan.idBits[slot >> 5] >> (slot & 31) & 1))
+				return false;
+		}
+		else if (!std::binary_search(plan.idList.begin(), plan.idList.end(), id)) {
+			return false;
+		}
+	}
+	for (const Test& test : plan.tests) {
+		if (!compare(test.column[row], test.op, test.value))
+			return false;
+	}
+	return true;
+}
+
+static void scanScalar(const Plan& plan, size_t begin, size_t end, std::vector<uint32_t>& rows) {
+	for (size_t row = begin; row < end; row++) {
+		if (matchRow(plan, row))
+			rows.push_back(static_cast<uint32_t>(row));
+	}
+}
+
+#ifdef CALLTABLE_X86
+static constexpr uint32_t SIGN = 0x80000000u;
+
+static void appendRows(unsigned bits, size_t row, std::vector<uint32_t>& rows) {
+	while (bits) {
+		rows.push_back(static_cast<uint32_t>(row + std::countr_zero(bits)));
+		bits &= bits - 1;
+	}
+}
+
+// Ordered comparisons are signed in SSE2 and AVX2; flipping the sign bit
+// of both sides makes them unsigned
+static uint32_t operandOf(const Test& test) {
+	return test.op == CallTable::Op::Eq || test.op == CallTable::Op::Ne ? test.value : test.value ^ SIGN;
+}
+
+static void scanSse2(const Plan& plan, size_t begin, size_t end, std::vector<uint32_t>& rows) {
+	const __m128i ones = _mm_set1_epi32(-1);
+	const __m128i sign = _mm_set1_epi32(static_cast<int32_t>(SIGN));
+	const __m128i thread = _mm_set1_epi32(static_cast<int32_t>(plan.thread));
+	__m128i ids[CallTable::MAX_VECTOR_IDS];
+	for (size_t i = 0; i < plan.idList.size(); i++)
+		ids[i] = _mm_set1_epi32(static_cast<int32_t>(plan.idList[i]));
+	__m128i operands[MAX_CONDITIONS];
+	for (size_t i = 0; i < plan.tests.size(); i++)
+		operands[i] = _mm_set1_epi32(static_cast<int32_t>(operandOf(plan.tests[i])));
+
+	size_t row = begin;
+	for (; row + 4 <= end; row += 4) {
+		__m128i mask = ones;
+		if (!plan.anyId) {
+			const __m128i id = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plan.ids + row));
+			mask = _mm_setzero_si128();
+			for (size_t i = 0; i < plan.idList.size(); i++)
+				mask = _mm_or_si128(mask, _mm_cmpeq_epi32(id, ids[i]));
+		}
+		if (!plan.anyThread)
+			mask = _mm_and_si128(mask, _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(plan.threads + row)), thread));
+		for (size_t i = 0; i < plan.tests.size(); i++) {
+			const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plan.tests[i].column + row));
+			__m128i hit;
+			switch (plan.tests[i].op) {
+			case CallTable::Op::Eq:
+				hit = _mm_cmpeq_epi32(value, operands[i]);
+				break;
+			case CallTable::Op::Ne:
+				hit = _mm_xor_si128(_mm_cmpeq_epi32(value, operands[i]), ones);
+				break;
+			case CallTable::Op::Lt:
+				hit = _mm_cmplt_epi32(_mm_xor_si128(value, sign), operands[i]);
+				break;
+			case CallTable::Op::Ge:
+				hit = _mm_xor_si128(_mm_cmplt_epi32(_mm_xor_si128(value, sign), operands[i]), ones);
+				break;
+			case CallTable::Op::Gt:
+				hit = _mm_cmpgt_epi32(_mm_xor_si128(value, sign), operands[i]);
+				break;
+			case CallTable::Op::Le:
+			default:
+				hit = _mm_xor_si128(_mm_cmpgt_epi32(_mm_xor_si128(value, sign), operands[i]), ones);
+				break;
+			}
+			mask = _mm_and_si128(mask, hit);
+		}
+		appendRows(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(mask))), row, rows);
+	}
+	scanScalar(plan, row, end, rows);
+}
+
+TARGET_AVX2 static void scanAvx2(const Plan& plan, size_t begin, size_t end, std::vector<uint32_t>& rows) {
+	const __m256i ones = _mm256_set1_epi32(-1);
+	const __m256i sign = _mm256_set1_epi32(static_cast<int32_t>(SIGN));
+	const __m256i thread = _mm256_set1_epi32(static_cast<int32_t>(plan.thread));
+	const __m256i idBase = _mm256_set1_epi32(static_cast<int32_t>(plan.idBase));
+	const __m256i idSpan = _mm256_set1_epi32(static_cast<int32_t>(plan.idSpan ^ SIGN));
+	const __m256i low5 = _mm256_set1_epi32(31);
+	const __m256i one = _mm256_set1_epi32(1);
+	__m256i ids[CallTable::MAX_VECTOR_IDS];
+	for (size_t i = 0; plan.idBits.empty() && i < plan.idList.size(); i++)
+		ids[i] = _mm256_set1_epi32(static_cast<int32_t>(plan.idList[i]));
+	__m256i operands[MAX_CONDITIONS];
+	for (size_t i = 0; i < plan.tests.size(); i++)
+		operands[i] = _mm256_set1_epi32(static_cast<int32_t>(operandOf(plan.tests[i])));
+
+	size_t row = begin;
+	for (; row + 8 <= end; row += 8) {
+		__m256i mask = ones;
+		if (!plan.anyId) {
+			const __m256i id = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(plan.ids + row));
+			if (plan.idBits.empty()) {
+				mask = _mm256_setzero_si256();
+				for (size_t i = 0; i < plan.idList.size(); i++)
+					mask = _mm256_or_si256(mask, _mm256_cmpeq_epi32(id, ids[i]));
+			}
+			else {
+				// Only lanes inside the bitmap gather their word
+				const __m256i slot = _mm256_sub_epi32(id, idBase);
+				const __m256i inside = _mm256_cmpgt_epi32(idSpan, _mm256_xor_si256(slot, sign));
+				const __m256i word = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), reinterpret_cast<const int*>(plan.idBits.data()),
+					_mm256_srli_epi32(slot, 5), inside, 4);
+				const __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(word, _mm256_and_si256(slot, low5)), one);
+				mask = _mm256_cmpeq_epi32(bit, one);
+			}
+		}
+		if (!plan.anyThread)
+			mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(plan.threads + row)), thread));
+		for (size_t i = 0; i < plan.tests.size(); i++) {
+			const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(plan.tests[i].column + row));
+			__m256i hit;
+			switch (plan.tests[i].op) {
+			case CallTable::Op::Eq:
+				hit = _mm256_cmpeq_epi32(value, operands[i]);
+				break;
+			case CallTable::Op::Ne:
+				hit = _mm256_xor_si256(_mm256_cmpeq_epi32(value, operands[i]), ones);
+				break;
+			case CallTable::Op::Lt:
+				hit = _mm256_cmpgt_epi32(operands[i], _mm256_xor_si256(value, sign));
+				break;
+			case CallTable::Op::Ge:
+				hit = _mm256_xor_si256(_mm256_cmpgt_epi32(operands[i], _mm256_xor_si256(value, sign)), ones);
+				break;
+			case CallTable::Op::Gt:
+				hit = _mm256_cmpgt_epi32(_mm256_xor_si256(value, sign), operands[i]);
+				break;
+			case CallTable::Op::Le:
+			default:
+				hit = _mm256_xor_si256(_mm256_cmpgt_epi32(_mm256_xor_si256(value, sign), operands[i]), ones);
+				break;
+			}
+			mask = _mm256_and_si256(mask, hit);
+		}
+		appendRows(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask))), row, rows);
+	}
+	scanScalar(plan, row, end, rows);
+}
+#endif
+
+CallTable::Isa CallTable::GetBestIsa() {
+#ifdef CALLTABLE_X86
+#ifdef __GNUC__
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+#else
+	// AVX2 in the CPU and its registers saved by the OS
+	static const bool avx2 = [] {
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuid(info, 1);
+		const bool osxsave = info[2] & (1 << 27);
+		__cpuidex(info, 7, 0);
+		return osxsave && (info[1] & (1 << 5)) && (_xgetbv(0) & 6) == 6;
+	}();
+#endif
+	return avx2 ? Isa::Avx2 : Isa::Sse2;
+#else
+	return Isa::Scalar;
+#endif
+}
+
+std::vector<uint32_t> CallTable::Filter(const Query& query, Isa isa) const {
+	std::vector<uint32_t> rows;
+
+	// Rows are in block order, so the frame range is a row range
+	const size_t begin = std::lower_bound(frames.begin(), frames.end(), query.firstFrame) - frames.begin();
+	const size_t end = std::lower_bound(frames.begin() + begin, frames.end(), query.endFrame) - frames.begin();
+	if (begin >= end)
+		return rows;
+
+	Plan plan;
+	plan.ids = ids.data();
+	plan.threads = threads.data();
+	plan.anyThread = query.anyThread;
+	if (!query.anyThread) {
+		auto thread = threadIndex.find(query.thread);
+		if (thread == threadIndex.end())
+			return rows;
+		plan.thread = thread->second;
+	}
+
+	plan.anyId = query.ids.empty();
+	plan.idList = query.ids;
+	std::sort(plan.idList.begin(), plan.idList.end());
+	if (plan.idList.size() > MAX_VECTOR_IDS) {
+		plan.idBase = plan.idList.front();
+		if (plan.idList.back() - plan.idBase < MAX_BITMAP_IDS) {
+			plan.idSpan = plan.idList.back() - plan.idBase + 1;
+			plan.idBits.resize((plan.idSpan + 31) / 32);
+			for (uint32_t id : plan.idList) {
+				const uint32_t slot = id - plan.idBase;
+				plan.idBits[slot >> 5] |= 1u << (slot & 31);
+			}
+		}
+		if (isa == Isa::Sse2 || plan.idBits.empty())
+			isa = Isa::Scalar;
+	}
+
+	for (const Condition& condition : query.conditions) {
+		if (condition.column >= HOT_PARAMS)
+			return rows;
+		plan.tests.push_back({ params[condition.column].data(), condition.op, condition.value });
+	}
+	if (plan.tests.size() > MAX_CONDITIONS)
+		isa = Isa::Scalar;
+
+	switch (isa) {
+#ifdef CALLTABLE_X86
+	case Isa::Avx2:
+		scanAvx2(plan, begin, end, rows);
+		break;
+	case Isa::Sse2:
+		scanSse2(plan, begin, end, rows);
+		break;
+#endif
+	default:
+		scanScalar(plan, begin, end, rows);
+		break;
+	}
+	return rows;
+}
+
+// Queries from Parse() differ in the columns their conditions test, rows
+// matching any of them are returned in order
+std::vector<uint32_t> CallTable::Filter(std::span<const Query> queries, Isa isa) const {
+	std::vector<uint32_t> rows;
+	for (const Query& query : queries) {
+		std::vector<uint32_t> matched = Filter(query, isa);
+		if (rows.empty()) {
+			rows = std::move(matched);
+			continue;
+		}
+		std::vector<uint32_t> merged;
+		merged.reserve(rows.size() + matched.size());
+		std::set_union(rows.begin(), rows.end(), matched.begin(), matched.end(), std::back_inserter(merged));
+		rows = std::move(merged);
+	}
+	return rows;
+}
+
+template<typename T>
+static bool parseNumber(std::string_view text, T& value) {
+	int base = 10;
+	if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+		text.remove_prefix(2);
+		base = 16;
+	}
+	const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+	return ec == std::errc() && end == text.data() + text.size();
+}
+
+// Frames are numbered from 1 like in the UI, "100-900" or "100"
+static bool parseFrames(std::string_view text, CallTable::Query& query) {
+	const size_t dash = text.find('-');
+	uint32_t first = 0;
+	uint32_t last = 0;
+	if (!parseNumber(text.substr(0, dash), first))
+		return false;
+	if (dash == std::string_view::npos)
+		last = first;
+	else if (!parseNumber(text.substr(dash + 1), last))
+		return false;
+	if (first < 1 || last < first)
+		return false;
+	query.firstFrame = first - 1;
+	query.endFrame = last;
+	return true;
+}
+
+// Terms separated by spaces, all of them must hold:
+//   vkCmdDraw* or vkQueueSubmit  calls by name, a trailing * matches a prefix
+//   0x0001105a                    calls by ID, for calls the table lacks
+//   frames:100-900 or frame:100   frame range as numbered in the UI
+//   thread:3                      capture thread ID
+//   instanceCount>1               a leading parameter by name, with one of
+//                                 == != < <= > >= and an unsigned 32-bit
+//                                 number
+// Several names or IDs are alternatives; with conditions, IDs must be in
+// the table. A parameter may sit at different positions in different
+// calls, which gives one query per layout.
+bool CallTable::Parse(std::string_view text, std::vector<Query>& queries, std::string& error) {
+	struct Named {
+		std::string_view param;
+		Op op;
+		uint32_t value;
+	};
+	static const std::pair<std::string_view, Op> OPS[] = {
+		{ "==", Op::Eq }, { "!=", Op::Ne }, { "<=", Op::Le }, { ">=", Op::Ge },
+		{ "<", Op::Lt }, { ">", Op::Gt }, { "=", Op::Eq },
+	};
+
+	Query base;
+	std::vector<const CallInfo*> calls;
+	std::vector<uint32_t> rawIds;
+	std::vector<Named> named;
+	bool byName = false;
+
+	size_t pos = 0;
+	while (pos < text.size()) {
+		const size_t start = text.find_first_not_of(" \t", pos);
+		if (start == std::string_view::npos)
+			break;
+		const size_t stop = std::min(text.find_first_of(" \t", start), text.size());
+		const std::string_view term = text.substr(start, stop - start);
+		pos = stop;
+
+		if (term.starts_with("frames:") || term.starts_with("frame:")) {
+			if (!parseFrames(term.substr(term.find(':') + 1), base)) {
+				error = "Bad frame range " + std::string(term);
+				return false;
+			}
+			continue;
+		}
+		if (term.starts_with("thread:")) {
+			if (!parseNumber(term.substr(7), base.thread)) {
+				error = "Bad thread " + std::string(term);
+				return false;
+			}
+			base.anyThread = false;
+			continue;
+		}
+
+		const size_t opAt = term.find_first_of("=!<>");
+		if (opAt != std::string_view::npos) {
+			auto op = std::find_if(std::begin(OPS), std::end(OPS), [&](const std::pair<std::string_view, Op>& entry) {
+				return term.substr(opAt).starts_with(entry.first);
+			});
+			int64_t value = 0;
+			if (opAt == 0 || op == std::end(OPS) || !parseNumber(term.substr(opAt + op->first.size()), value)) {
+				error = "Bad condition " + std::string(term);
+				return false;
+			}
+			// Columns hold parameters as unsigned 32-bit values
+			if (value < 0 || value > UINT32_MAX) {
+				error = "Value out of range in " + std::string(term) + ", conditions compare unsigned 32-bit values";
+				return false;
+			}
+			named.push_back({ term.substr(0, opAt), op->second, static_cast<uint32_t>(value) });
+			continue;
+		}
+
+		byName = true;
+		uint32_t id = 0;
+		if (term.starts_with("0x") && parseNumber(term, id)) {
+			rawIds.push_back(id);
+			continue;
+		}
+		const bool prefix = term.ends_with('*');
+		const std::string_view name = prefix ? term.substr(0, term.size() - 1) : term;
+		size_t found = 0;
+		for (const CallInfo& call : Calls()) {
+			const std::string_view callName = call.name;
+			if (prefix ? callName.starts_with(name) : callName == name) {
+				calls.push_back(&call);
+				found++;
+			}
+		}
+		if (!found) {
+			error = "No call named " + std::string(term);
+			return false;
+		}
+	}
+
+	queries.clear();
+	if (named.empty()) {
+		for (const CallInfo* call : calls)
+			base.ids.push_back(call->id);
+		base.ids.insert(base.ids.end(), rawIds.begin(), rawIds.end());
+		std::sort(base.ids.begin(), base.ids.end());
+		base.ids.erase(std::unique(base.ids.begin(), base.ids.end()), base.ids.end());
+		queries.push_back(std::move(base));
+		return true;
+	}
+	if (named.size() > MAX_CONDITIONS) {
+		error = "Too many conditions";
+		return false;
+	}
+
+	// Calls without every named parameter among the hot ones cannot match.
+	// Raw IDs need a table entry to know where their parameters are.
+	if (!byName) {
+		for (const CallInfo& call : Calls())
+			calls.push_back(&call);
+	}
+	for (uint32_t id : rawIds) {
+		const CallInfo* call = FindCall(id);
+		if (!call) {
+			char hex[16];
+			snprintf(hex, sizeof(hex), "0x%08x", id);
+			error = "Call " + std::string(hex) + " is not in the call table, its parameters cannot be named";
+			return false;
+		}
+		calls.push_back(call);
+	}
+	std::map<std::vector<uint8_t>, std::vector<uint32_t>> layouts;
+	for (const CallInfo* call : calls) {
+		std::vector<uint8_t> columns;
+		for (const Named& condition : named) {
+			const size_t count = std::min<size_t>(call->paramCount, HOT_PARAMS + 1);
+			for (size_t i = 1; i < count; i++) {
+				if (condition.param == call->params[i].name) {
+					columns.push_back(static_cast<uint8_t>(i - 1));
+					break;
+				}
+			}
+		}
+		if (columns.size() == named.size())
+			layouts[columns].push_back(call->id);
+	}
+	if (layouts.empty()) {
+		error = "No matching call has " + std::string(named[0].param) + " among its first " + std::to_string(HOT_PARAMS) + " parameters after the handle";
+		return false;
+	}
+
+	for (auto& [columns, callIds] : layouts) {
+		Query query = base;
+		std::sort(callIds.begin(), callIds.end());
+		callIds.erase(std::unique(callIds.begin(), callIds.end()), callIds.end());
+		query.ids = std::move(callIds);
+		for (size_t i = 0; i < named.size(); i++)
+			query.conditions.push_back({ columns[i], named[i].op, named[i].value });
+		queries.push_back(std::move(query));
+	}
+	return true;
+}
+
+}
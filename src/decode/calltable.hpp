@@ -0,0 +1,112 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "vulkancalls.hpp"
+
+namespace vkdecode {
+
+// The calls of a whole capture as columns, one row per call in block
+// order: call ID, frame, thread, block index and the leading scalar
+// parameters. Threads are stored as an index into the thread IDs seen, so
+// every scanned column is 32 bits wide. Filter() scans the columns 8 rows
+// at a time with AVX2 or 4 with SSE2, whichever the CPU has, and falls
+// back to one row at a time elsewhere.
+class CallTable {
+public:
+    // Parameters 1 to HOT_PARAMS, the one before them is the dispatchable
+    // handle. Values keep their low 32 bits and compare unsigned.
+    static constexpr size_t HOT_PARAMS = 4;
+    // Longer ID lists are tested against a bitmap, with gathers in AVX2
+    static constexpr size_t MAX_VECTOR_IDS = 16;
+
+    enum class Op : uint8_t {
+        Eq,
+        Ne,
+        Lt,
+        Le,
+        Gt,
+        Ge,
+    };
+
+    enum class Isa : uint8_t {
+        Scalar,
+        Sse2,
+        Avx2,
+    };
+
+    struct Condition {
+        // Hot parameter column, 0 for parameter 1
+        uint8_t column;
+        Op op;
+        uint32_t value;
+    };
+
+    // Calls with one of ids (any if empty) in frames [firstFrame, endFrame)
+    // passing every condition
+    struct Query {
+        std::vector<uint32_t> ids;
+        uint32_t firstFrame = 0;
+        uint32_t endFrame = UINT32_MAX;
+        bool anyThread = true;
+        uint64_t thread = 0;
+        std::vector<Condition> conditions;
+    };
+
+    CallTable();
+    ~CallTable();
+    void Reserve(size_t rows);
+    void Append(uint32_t id, uint32_t frame, uint64_t thread, uint32_t block, const Value* values, size_t count);
+    size_t GetRowCount() const;
+    std::span<const uint32_t> GetIds() const;
+    std::span<const uint32_t> GetFrames() const;
+    std::span<const uint32_t> GetBlocks() const;
+    uint64_t GetThread(size_t row) const;
+    size_t GetBytes() const;
+
+    std::vector<uint32_t> Filter(const Query& query, Isa isa = GetBestIsa()) const;
+    std::vector<uint32_t> Filter(std::span<const Query> queries, Isa isa = GetBestIsa()) const;
+    static bool Parse(std::string_view text, std::vector<Query>& queries, std::string& error);
+    static Isa GetBestIsa();
+
+private:
+    std::vector<uint32_t> ids;
+    std::vector<uint32_t> frames;
+    std::vector<uint32_t> threads;
+    std::vector<uint32_t> blocks;
+    std::vector<uint32_t> params[HOT_PARAMS];
+    std::vector<uint64_t> threadIds;
+    std::unordered_map<uint64_t, uint32_t> threadIndex;
+};
+
+}
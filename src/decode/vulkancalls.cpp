@@ -0,0 +1,191 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "vulkancalls.hpp"
+
+#include <array>
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+namespace vkdecode {
+
+#ifdef GFXR_VIEWER_HAS_VULKAN_REGISTRY
+#include "vulkancalltable.inc"
+#else
+// Built without the registry, calls are shown by ID
+namespace generated {
+constexpr uint32_t FIRST_ID = 0;
+constexpr std::array<CallInfo, 0> CALLS = {};
+constexpr std::array<uint16_t, 0> INDEX = {};
+constexpr std::array<std::pair<int32_t, const char*>, 0> RESULTS = {};
+}
+#endif
+
+static constexpr uint16_t NONE = 0xffff;
+
+static constexpr bool isSorted() {
+	for (size_t i = 1; i < generated::CALLS.size(); i++) {
+		if (generated::CALLS[i - 1].id >= generated::CALLS[i].id)
+			return false;
+	}
+	return true;
+}
+
+static constexpr bool isIndexed() {
+	for (size_t i = 0; i < generated::INDEX.size(); i++) {
+		const uint16_t call = generated::INDEX[i];
+		if (call != NONE && (call >= generated::CALLS.size() || generated::CALLS[call].id != generated::FIRST_ID + i))
+			return false;
+	}
+	for (const CallInfo& call : generated::CALLS) {
+		if (call.paramCount + 1u > MAX_VALUES)
+			return false;
+	}
+	return true;
+}
+
+static_assert(isSorted(), "Generated call table is not sorted by ID");
+static_assert(isIndexed(), "Generated call index does not match the table");
+static_assert(generated::CALLS.size() < NONE);
+
+const CallInfo* FindCall(uint32_t id) {
+	const uint64_t slot = static_cast<uint64_t>(id) - generated::FIRST_ID;
+	if (id < generated::FIRST_ID || slot >= generated::INDEX.size() || generated::INDEX[slot] == NONE)
+		return nullptr;
+	return &generated::CALLS[generated::INDEX[slot]];
+}
+
+size_t CallCount() {
+	return generated::CALLS.size();
+}
+
+std::span<const CallInfo> Calls() {
+	return generated::CALLS;
+}
+
+const char* ResultName(int32_t result) {
+	auto it = std::lower_bound(generated::RESULTS.begin(), generated::RESULTS.end(), result, [](const std::pair<int32_t, const char*>& entry, int32_t result) {
+		return entry.first < result;
+	});
+	return it != generated::RESULTS.end() && it->first == result ? it->second : nullptr;
+}
+
+std::string FormatValue(const Value& value) {
+	char text[32];
+	switch (value.kind) {
+	case Kind::Handle:
+	case Kind::U64:
+	case Kind::U32:
+		snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(value.bits));
+		break;
+	case Kind::I32:
+	case Kind::Enum:
+		snprintf(text, sizeof(text), "%d", static_cast<int32_t>(value.bits));
+		break;
+	case Kind::I64:
+		snprintf(text, sizeof(text), "%lld", static_cast<long long>(value.bits));
+		break;
+	case Kind::F32:
+	{
+		float f;
+		const uint32_t bits = static_cast<uint32_t>(value.bits);
+		memcpy(&f, &bits, sizeof(f));
+		snprintf(text, sizeof(text), "%g", f);
+		break;
+	}
+	case Kind::Bool32:
+		if (value.bits <= 1)
+			return value.bits ? "VK_TRUE" : "VK_FALSE";
+		snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(value.bits));
+		break;
+	case Kind::Flags:
+	case Kind::Flags64:
+		snprintf(text, sizeof(text), "0x%llx", static_cast<unsigned long long>(value.bits));
+		break;
+	case Kind::Result:
+	{
+		const char* name = ResultName(static_cast<int32_t>(value.bits));
+		if (name)
+			return name;
+		snprintf(text, sizeof(text), "%d", static_cast<int32_t>(value.bits));
+		break;
+	}
+	}
+	return text;
+}
+
+// Nothing here touches the heap once the arena has its chunks and the
+// names of unknown calls are interned
+DecodedCall* DecodeCall(uint32_t id, const uint8_t* params, uint64_t size, Arena& arena, StringTable& names) {
+	DecodedCall* call = arena.New<DecodedCall>();
+	call->id = id;
+	call->info = FindCall(id);
+	call->values = nullptr;
+	call->valueCount = 0;
+	call->thread = 0;
+	call->object = 0;
+	call->paramSize = size;
+	if (!call->info) {
+		char name[16];
+		snprintf(name, sizeof(name), "0x%08x", id);
+		call->name = names.Intern(name);
+		return call;
+	}
+
+	Value values[MAX_VALUES];
+	const size_t count = params ? call->info->decode(params, size, values) : 0;
+	call->name = call->info->name;
+	call->values = arena.NewArray(values, count);
+	call->valueCount = static_cast<uint8_t>(count);
+	return call;
+}
+
+std::string FormatCall(const DecodedCall& call) {
+	std::string text(call.name);
+	if (!call.info)
+		return text;
+
+	const CallInfo& info = *call.info;
+	text += '(';
+	const size_t shown = std::min<size_t>(call.valueCount, info.paramCount);
+	for (size_t i = 0; i < shown; i++) {
+		if (i)
+			text += ", ";
+		text += info.params[i].name;
+		text += '=';
+		text += FormatValue(call.values[i]);
+	}
+	if (!info.complete || shown < info.paramCount)
+		text += shown ? ", ..." : "...";
+	text += ')';
+
+	if (info.returns && call.valueCount > info.paramCount) {
+		text += " = ";
+		text += FormatValue(call.values[info.paramCount]);
+	}
+	return text;
+}
+
+}
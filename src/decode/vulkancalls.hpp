@@ -0,0 +1,157 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "arena.hpp"
+#include "stringtable.hpp"
+
+// Vulkan call names and parameter decoders for GFXReconstruct function call
+// blocks. The table is generated at build time from the Vulkan registry
+// (vk.xml) by tools/codegen/gen_vulkan_calls.py and looked up by direct
+// index on the call ID. Parameters are decoded up to the first pointer or
+// array one; those carry GFXReconstruct's own pointer encoding and are
+// left for a full decoder.
+namespace vkdecode {
+
+enum class Kind : uint8_t {
+    Handle,
+    U32,
+    I32,
+    U64,
+    I64,
+    F32,
+    Bool32,
+    Enum,
+    Flags,
+    Flags64,
+    Result,
+};
+
+struct Value {
+    Kind kind;
+    uint64_t bits;
+};
+
+struct Param {
+    const char* name;
+    Kind kind;
+};
+
+// Decodes up to the count of a call's params into out, returns how many
+using DecodeFn = size_t (*)(const uint8_t* data, uint64_t size, Value* out);
+
+struct CallInfo {
+    uint32_t id;
+    const char* name;
+    const Param* params;
+    uint8_t paramCount;
+    // Every parameter is decodable, so is the return value after them
+    bool complete;
+    bool returns;
+    DecodeFn decode;
+};
+
+// The largest paramCount, plus the return value
+constexpr size_t MAX_VALUES = 32;
+
+// A decoded call as kept for display. Lives in the arena of its decode
+// batch; the name is static or interned, and values points into the same
+// arena.
+struct DecodedCall {
+    uint32_t id;
+    std::string_view name;
+    const CallInfo* info;
+    const Value* values;
+    uint8_t valueCount;
+    uint64_t thread;
+    uint64_t object;
+    uint64_t paramSize;
+};
+
+constexpr uint64_t SizeOf(Kind kind) {
+    switch (kind) {
+    case Kind::Handle:
+    case Kind::U64:
+    case Kind::I64:
+    case Kind::Flags64:
+        return 8;
+    default:
+        return 4;
+    }
+}
+
+// Handles are recorded as 64 bit IDs and size_t as 64 bit, whatever the
+// capturing platform
+template<Kind K>
+inline uint64_t ReadValue(const uint8_t* data) {
+    if constexpr (SizeOf(K) == 8) {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    else {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+}
+
+// One instance per parameter layout, the table points straight at them
+template<Kind... Kinds>
+size_t DecodeParams(const uint8_t* data, uint64_t size, Value* out) {
+    if constexpr (sizeof...(Kinds) == 0) {
+        return 0;
+    }
+    else {
+        size_t count = 0;
+        uint64_t offset = 0;
+        auto next = [&]<Kind K>() {
+            if (offset + SizeOf(K) > size)
+                return false;
+            out[count++] = { K, ReadValue<K>(data + offset) };
+            offset += SizeOf(K);
+            return true;
+        };
+        (void)(next.template operator()<Kinds>() && ...);
+        return count;
+    }
+}
+
+const CallInfo* FindCall(uint32_t id);
+size_t CallCount();
+std::span<const CallInfo> Calls();
+const char* ResultName(int32_t result);
+std::string FormatValue(const Value& value);
+DecodedCall* DecodeCall(uint32_t id, const uint8_t* params, uint64_t size, Arena& arena, StringTable& names);
+std::string FormatCall(const DecodedCall& call);
+
+}
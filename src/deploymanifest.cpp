@@ -0,0 +1,163 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "deploymanifest.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QStandardPaths>
+#include <QRegularExpression>
+#include <QCryptographicHash>
+
+#include <map>
+#include <mutex>
+#include "common.hpp"
+
+DeployManifest::DeployManifest(std::string serial) {
+	QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
+	dir.mkpath("deploy");
+	// Network serials look like host:port
+	QString name = QString::fromStdString(serial).replace(QRegularExpression("[^A-Za-z0-9._-]"), "_");
+	file = dir.filePath(QString("deploy/%1.json").arg(name));
+	chunkDir = dir.filePath(QString("deploy/%1.chunks").arg(name));
+
+	QFile f(file);
+	if (f.open(QIODevice::ReadOnly))
+		entries = QJsonDocument::fromJson(f.readAll()).object();
+}
+
+DeployManifest::~DeployManifest() {
+}
+
+bool DeployManifest::Find(const QString& key, Entry& entry) const {
+	if (!entries.contains(key))
+		return false;
+
+	QJsonObject value = entries.value(key).toObject();
+	entry.hash = value.value("hash").toString();
+	entry.path = value.value("path").toString();
+	entry.size = value.value("size").toInteger(-1);
+	entry.stamp = value.value("stamp").toString();
+	return !entry.hash.isEmpty();
+}
+
+void DeployManifest::Put(const QString& key, const Entry& entry) {
+	QJsonObject value;
+	value.insert("hash", entry.hash);
+	value.insert("path", entry.path);
+	value.insert("size", entry.size);
+	value.insert("stamp", entry.stamp);
+	entries.insert(key, value);
+	save();
+}
+
+void DeployManifest::Remove(const QString& key) {
+	entries.remove(key);
+	save();
+}
+
+bool DeployManifest::FindChunks(const QString& remote, std::vector<Chunker::Chunk>& chunks) const {
+	QFile f(chunkFile(remote));
+	if (!f.open(QIODevice::ReadOnly))
+		return false;
+
+	const QJsonObject record = QJsonDocument::fromJson(f.readAll()).object();
+	if (record.value("path").toString() != remote)
+		return false;
+
+	// Chunks are stored back to back as [length, hash]
+	chunks.clear();
+	qint64 offset = 0;
+	for (const QJsonValue& value : record.value("chunks").toArray()) {
+		const QJsonArray chunk = value.toArray();
+		const qint64 length = chunk.at(0).toInteger(0);
+		if (length <= 0)
+			return false;
+		chunks.push_back({ offset, length, chunk.at(1).toString().toLatin1() });
+		offset += length;
+	}
+	return !chunks.empty();
+}
+
+void DeployManifest::PutChunks(const QString& remote, const std::vector<Chunker::Chunk>& chunks) {
+	QJsonArray list;
+	for (const Chunker::Chunk& chunk : chunks)
+		list.append(QJsonArray{ chunk.length, QString::fromLatin1(chunk.hash) });
+
+	QDir().mkpath(chunkDir);
+	QFile f(chunkFile(remote));
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		LOGD("Failed to write chunk record %s", f.fileName().toStdString().c_str());
+		return;
+	}
+	f.write(QJsonDocument(QJsonObject{ { "path", remote }, { "chunks", list } }).toJson(QJsonDocument::Compact));
+}
+
+void DeployManifest::RemoveChunks(const QString& remote) {
+	QFile::remove(chunkFile(remote));
+}
+
+QString DeployManifest::chunkFile(const QString& remote) const {
+	const QByteArray name = QCryptographicHash::hash(remote.toUtf8(), QCryptographicHash::Sha1).toHex();
+	return QDir(chunkDir).filePath(QString::fromLatin1(name) + ".json");
+}
+
+void DeployManifest::save() {
+	QFile f(file);
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		LOGD("Failed to write deploy manifest %s", file.toStdString().c_str());
+		return;
+	}
+	f.write(QJsonDocument(entries).toJson());
+}
+
+std::shared_future<QString> DeployManifest::LocalHash(const QString& path) {
+	static std::mutex mutex;
+	static std::map<QString, std::pair<QString, std::shared_future<QString>>> hashes;
+
+	QFileInfo info(path);
+	if (!info.isFile())
+		return std::async(std::launch::deferred, [] { return QString(); }).share();
+
+	const QString version = QString("%1:%2").arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = hashes.find(path);
+	if (it != hashes.end() && it->second.first == version)
+		return it->second.second;
+
+	std::shared_future<QString> hash = std::async(std::launch::async, [path] {
+		QFile f(path);
+		QCryptographicHash sha1(QCryptographicHash::Sha1);
+		if (!f.open(QIODevice::ReadOnly) || !sha1.addData(&f))
+			return QString();
+		return QString::fromLatin1(sha1.result().toHex());
+	}).share();
+	hashes[path] = { version, hash };
+	return hash;
+}
@@ -0,0 +1,71 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QJsonObject>
+
+#include <string>
+#include <future>
+#include <vector>
+
+#include "chunker.hpp"
+
+// Records what has been deployed to a device (the record layer per app and
+// ABI, the replay APK) by the SHA-1 of the local file it came from, so an
+// unchanged file is not deployed again and a changed one always is. Kept as
+// JSON per serial under the app data dir. Local hashes are computed in the
+// background and cached by path, size and mtime. The chunks of each synced
+// file are kept in a file of their own per remote path, so the next sync
+// knows where content sits on the device without the device chunking it.
+class DeployManifest {
+public:
+    struct Entry {
+        QString hash;
+        QString path;
+        qint64 size = -1;
+        QString stamp;
+    };
+
+    DeployManifest(std::string serial);
+    ~DeployManifest();
+    bool Find(const QString& key, Entry& entry) const;
+    void Put(const QString& key, const Entry& entry);
+    void Remove(const QString& key);
+    bool FindChunks(const QString& remote, std::vector<Chunker::Chunk>& chunks) const;
+    void PutChunks(const QString& remote, const std::vector<Chunker::Chunk>& chunks);
+    void RemoveChunks(const QString& remote);
+
+    static std::shared_future<QString> LocalHash(const QString& path);
+
+private:
+    void save();
+    QString chunkFile(const QString& remote) const;
+
+private:
+    QString file;
+    QString chunkDir;
+    QJsonObject entries;
+};
@@ -0,0 +1,85 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "deviceprofile.hpp"
+
+#include <QStringList>
+
+bool DeviceProfile::HasApplet(const QString& applet) const {
+	// An empty list means toybox could not be listed, assume the applet exists
+	return applets.isEmpty() || applets.contains(applet);
+}
+
+QString DeviceProfile::ProbeCommand() {
+	return "echo uid=$(id -u); "
+		"echo su=$(su 0 id -u 2>/dev/null); "
+		"echo runas=$(run-as com.lunarg.gfxreconstruct.replay id -u 2>/dev/null); "
+		"echo selinux=$(getenforce 2>/dev/null); "
+		"echo applets=$(toybox 2>/dev/null); "
+		"echo sdcard=$(df -k /sdcard 2>/dev/null | tail -n 1 | tr -s ' ' | cut -d ' ' -f 4); "
+		"echo tmp=$(df -k /data/local/tmp 2>/dev/null | tail -n 1 | tr -s ' ' | cut -d ' ' -f 4)";
+}
+
+bool DeviceProfile::Parse(const QString& raw, DeviceProfile& profile) {
+	profile = DeviceProfile();
+
+	QString uid, su, runAs;
+	for (const QString& line : raw.split('\n')) {
+		const QString key = line.section('=', 0, 0).trimmed();
+		const QString value = line.section('=', 1).trimmed();
+		if (key == "uid")
+			uid = value;
+		else if (key == "su")
+			su = value;
+		else if (key == "runas")
+			runAs = value;
+		else if (key == "selinux")
+			profile.selinux = value;
+		else if (key == "applets")
+			for (const QString& applet : value.split(' ', Qt::SkipEmptyParts))
+				profile.applets.insert(applet);
+		else if (key == "sdcard" && !value.isEmpty())
+			profile.sdcardFree = value.toLongLong() * 1024;
+		else if (key == "tmp" && !value.isEmpty())
+			profile.tmpFree = value.toLongLong() * 1024;
+	}
+
+	if (uid.isEmpty())
+		return false;
+
+	// adbd running as root needs no escalation at all
+	if (uid == "0") {
+		profile.root = true;
+		profile.escalation = Escalation::Shell;
+	}
+	else if (su == "0") {
+		profile.root = true;
+		profile.escalation = Escalation::Root;
+	}
+	else if (!runAs.isEmpty()) {
+		profile.escalation = Escalation::RunAs;
+	}
+
+	return true;
+}
@@ -0,0 +1,52 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QSet>
+
+// What a connected device allows, probed in a single shell round trip: how
+// privileged commands can be run, whether root is available, the SELinux
+// mode, the toybox applets present and the free space of the staging dirs.
+class DeviceProfile {
+public:
+    enum class Escalation {
+        Root,
+        RunAs,
+        Shell,
+    };
+
+    Escalation escalation = Escalation::Shell;
+    bool root = false;
+    QString selinux;
+    QSet<QString> applets;
+    qint64 sdcardFree = -1;
+    qint64 tmpFree = -1;
+
+    bool HasApplet(const QString& applet) const;
+
+    static QString ProbeCommand();
+    static bool Parse(const QString& raw, DeviceProfile& profile);
+};
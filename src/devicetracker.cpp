@@ -0,0 +1,192 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "devicetracker.hpp"
+
+#include <algorithm>
+#include "common.hpp"
+
+static const int RETRY_INTERVAL_MS = 1000;
+
+DeviceTracker::DeviceTracker(QObject* parent)
+	: QAbstractListModel(parent), socket(this), retryTimer(this), statusRead(false), tracking(false)
+{
+	retryTimer.setSingleShot(true);
+	retryTimer.setInterval(RETRY_INTERVAL_MS);
+
+	connect(&socket, &QTcpSocket::connected, this, &DeviceTracker::OnConnected);
+	connect(&socket, &QTcpSocket::readyRead, this, &DeviceTracker::OnReadyRead);
+	connect(&socket, &QTcpSocket::disconnected, this, &DeviceTracker::OnDisconnected);
+	connect(&socket, &QTcpSocket::errorOccurred, this, &DeviceTracker::OnDisconnected);
+	connect(&retryTimer, &QTimer::timeout, this, &DeviceTracker::Start);
+}
+
+DeviceTracker::~DeviceTracker() {
+	Stop();
+}
+
+void DeviceTracker::Start() {
+	if (socket.state() != QAbstractSocket::UnconnectedState)
+		return;
+
+	buffer.clear();
+	statusRead = false;
+	socket.connectToHost(client.GetHost(), client.GetPort());
+}
+
+void DeviceTracker::Stop() {
+	retryTimer.stop();
+	socket.blockSignals(true);
+	socket.abort();
+	socket.blockSignals(false);
+	SetTracking(false);
+}
+
+bool DeviceTracker::IsTracking() const {
+	return tracking;
+}
+
+int DeviceTracker::rowCount(const QModelIndex& parent) const {
+	return parent.isValid() ? 0 : static_cast<int>(devices.size());
+}
+
+QVariant DeviceTracker::data(const QModelIndex& index, int role) const {
+	if (!index.isValid() || index.row() >= rowCount())
+		return QVariant();
+
+	const AdbClient::Device& device = devices[index.row()];
+	switch (role) {
+	case Qt::DisplayRole:
+	{
+		QString text = QString::fromStdString(device.serial);
+		if (!device.model.empty())
+			text += QString("  %1").arg(QString::fromStdString(device.model).replace('_', ' '));
+		if (device.state != "device")
+			text += QString("  (%1)").arg(QString::fromStdString(device.state));
+		return text;
+	}
+	case SerialRole:
+		return QString::fromStdString(device.serial);
+	case StateRole:
+		return QString::fromStdString(device.state);
+	default:
+		return QVariant();
+	}
+}
+
+void DeviceTracker::OnConnected() {
+	socket.write(AdbClient::FormatRequest("host:track-devices-l"));
+}
+
+void DeviceTracker::OnReadyRead() {
+	buffer += socket.readAll();
+
+	if (!statusRead) {
+		if (buffer.size() < 4)
+			return;
+		if (!buffer.startsWith("OKAY")) {
+			LOGD("adb server rejected host:track-devices-l");
+			socket.abort();
+			OnDisconnected();
+			return;
+		}
+		buffer.remove(0, 4);
+		statusRead = true;
+		SetTracking(true);
+	}
+
+	// Every message is a complete snapshot, only the newest one matters
+	qsizetype offset = 0;
+	QByteArray snapshot;
+	bool updated = false;
+	while (buffer.size() - offset >= 4) {
+		bool ok = false;
+		const int length = buffer.mid(offset, 4).toInt(&ok, 16);
+		if (!ok) {
+			socket.abort();
+			OnDisconnected();
+			return;
+		}
+		if (buffer.size() - offset - 4 < length)
+			break;
+		snapshot = buffer.mid(offset + 4, length);
+		offset += 4 + length;
+		updated = true;
+	}
+	buffer.remove(0, offset);
+
+	if (updated)
+		Update(AdbClient::ParseDevices(snapshot));
+}
+
+void DeviceTracker::OnDisconnected() {
+	if (socket.state() != QAbstractSocket::UnconnectedState)
+		socket.abort();
+
+	SetTracking(false);
+	Update({});
+	if (!retryTimer.isActive())
+		retryTimer.start();
+}
+
+void DeviceTracker::Update(const std::vector<AdbClient::Device>& snapshot) {
+	auto find = [](const std::vector<AdbClient::Device>& list, const std::string& serial) {
+		return std::find_if(list.begin(), list.end(), [&serial](const AdbClient::Device& device) {
+			return device.serial == serial;
+		});
+	};
+
+	// Detached devices
+	for (int row = static_cast<int>(devices.size()) - 1; row >= 0; row--) {
+		if (find(snapshot, devices[row].serial) != snapshot.end())
+			continue;
+		beginRemoveRows(QModelIndex(), row, row);
+		devices.erase(devices.begin() + row);
+		endRemoveRows();
+	}
+
+	for (const AdbClient::Device& device : snapshot) {
+		auto it = find(devices, device.serial);
+		if (it == devices.end()) {
+			// Attached device
+			const int row = static_cast<int>(devices.size());
+			beginInsertRows(QModelIndex(), row, row);
+			devices.push_back(device);
+			endInsertRows();
+		}
+		else if (it->state != device.state || it->model != device.model || it->product != device.product) {
+			// Authorized, went offline, or properties became known
+			const int row = static_cast<int>(it - devices.begin());
+			devices[row] = device;
+			emit dataChanged(index(row), index(row));
+		}
+	}
+}
+
+void DeviceTracker::SetTracking(bool tracking) {
+	if (this->tracking == tracking)
+		return;
+	this->tracking = tracking;
+	emit TrackingChanged(tracking);
+}
@@ -0,0 +1,76 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <vector>
+
+#include "adbclient.hpp"
+
+// Live list of devices known to the adb server. Holds a host:track-devices-l
+// stream open on the GUI event loop; the server sends a full snapshot on
+// every change, which is diffed against the current rows so views only see
+// the rows that were inserted, removed or changed. Reconnects on its own
+// when the server goes away.
+class DeviceTracker : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Role {
+        SerialRole = Qt::UserRole,
+        StateRole,
+    };
+
+    DeviceTracker(QObject* parent = nullptr);
+    ~DeviceTracker();
+    void Start();
+    void Stop();
+    bool IsTracking() const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+signals:
+    void TrackingChanged(bool tracking);
+
+private:
+    void OnConnected();
+    void OnReadyRead();
+    void OnDisconnected();
+    void Update(const std::vector<AdbClient::Device>& snapshot);
+    void SetTracking(bool tracking);
+
+private:
+    AdbClient client;
+    QTcpSocket socket;
+    QTimer retryTimer;
+    QByteArray buffer;
+    bool statusRead;
+    bool tracking;
+    std::vector<AdbClient::Device> devices;
+};
@@ -26,7 +26,10 @@
 #include <filesystem>
 #include <cstdio>
 #include <cstdarg>
+#include <mutex>
 #include <QMessageBox>
+#include <QThread>
+#include <QApplication>
 #include "log.hpp"
 
 Logger::Logger() {
@@ -36,6 +39,19 @@ Logger::~Logger() {
 }
 
 void Logger::log(const char* file, int line, const char* func, Logger::Level level, const char* format, ...) {
+    static std::recursive_mutex mutex;
+
+    va_list argptr;
+    va_start(argptr, format);
+    const QString message = QString::vasprintf(format, argptr);
+    va_end(argptr);
+
+    // Message boxes need a QApplication (console tools only print) and can
+    // only be shown from the GUI thread
+    QApplication* app = qobject_cast<QApplication*>(QCoreApplication::instance());
+    const bool guiThread = app && QThread::currentThread() == app->thread();
+
+    std::unique_lock<std::recursive_mutex> lock(mutex);
     std::time_t now = std::time(nullptr);
     std::cout << std::put_time(std::localtime(&now), "%c ");
 
@@ -55,17 +71,18 @@ void Logger::log(const char* file, int line, const char* func, Logger::Level lev
     }
 
     printf(infoStr, file, line, func);
+    std::cout << message.toStdString() << std::endl;
+    lock.unlock();
 
-    va_list argptr;
-    va_start(argptr, format);
-    vprintf(format, argptr);
-    if (level == Warn)
-        QMessageBox::warning(nullptr, "", QString::vasprintf(format, argptr));
-    else if (level == Error)
-        QMessageBox::critical(nullptr, "", QString::vasprintf(format, argptr));
-    va_end(argptr);
-
-    std::cout << std::endl;
+    // Worker threads hand warnings to the GUI thread instead of dropping them
+    if (level == Warn && guiThread)
+        QMessageBox::warning(nullptr, "", message);
+    else if (level == Warn && app)
+        QMetaObject::invokeMethod(app, [message]() {
+            QMessageBox::warning(nullptr, "", message);
+        }, Qt::QueuedConnection);
+    else if (level == Error && guiThread)
+        QMessageBox::critical(nullptr, "", message);
 
     if (level == Error)
         abort();
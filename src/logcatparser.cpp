@@ -0,0 +1,149 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "logcatparser.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <limits>
+
+// logger_entry v1 had a padding field where later versions store the header
+// size; v4 is 28 bytes, anything past that is a newer header we skip over
+static const size_t HEADER_V1_SIZE = 20;
+static const size_t HEADER_MAX_SIZE = 100;
+static const size_t SIZE_PREFIX = 4;
+static const size_t INVALID_SIZE = std::numeric_limits<size_t>::max();
+
+template<typename T>
+static T readLE(const char* data) {
+	T value;
+	memcpy(&value, data, sizeof(T));
+	return value;
+}
+
+double LogcatParser::Entry::Time() const {
+	return sec + nsec / 1e9;
+}
+
+LogcatParser::LogcatParser(Sink sink)
+	: sink(sink), valid(true), entries(0)
+{
+}
+
+LogcatParser::~LogcatParser() {
+}
+
+bool LogcatParser::IsValid() const {
+	return valid;
+}
+
+uint64_t LogcatParser::GetEntries() const {
+	return entries;
+}
+
+size_t LogcatParser::entrySize(const char* data, size_t size) const {
+	if (size < SIZE_PREFIX)
+		return 0;
+
+	const size_t payload = readLE<uint16_t>(data);
+	size_t header = readLE<uint16_t>(data + 2);
+	if (header == 0)
+		header = HEADER_V1_SIZE;
+
+	// At least a priority byte and the tag terminator
+	if (header < HEADER_V1_SIZE || header > HEADER_MAX_SIZE || payload < 2)
+		return INVALID_SIZE;
+	return header + payload;
+}
+
+void LogcatParser::parse(const char* data, size_t size) {
+	size_t header = readLE<uint16_t>(data + 2);
+	if (header == 0)
+		header = HEADER_V1_SIZE;
+
+	Entry entry;
+	entry.pid = readLE<int32_t>(data + 4);
+	entry.tid = readLE<uint32_t>(data + 8);
+	entry.sec = readLE<uint32_t>(data + 12);
+	entry.nsec = readLE<uint32_t>(data + 16);
+
+	const char* payload = data + header;
+	const size_t length = size - header;
+	entry.priority = static_cast<uint8_t>(payload[0]);
+
+	std::string_view rest(payload + 1, length - 1);
+	const size_t tagEnd = rest.find('\0');
+	if (tagEnd == std::string_view::npos) {
+		entry.tag = rest;
+	}
+	else {
+		entry.tag = rest.substr(0, tagEnd);
+		entry.message = rest.substr(tagEnd + 1);
+	}
+
+	while (!entry.message.empty() && (entry.message.back() == '\0' || entry.message.back() == '\n'))
+		entry.message.remove_suffix(1);
+
+	entries++;
+	if (sink)
+		sink(entry);
+}
+
+bool LogcatParser::Feed(const char* data, size_t size) {
+	size_t offset = 0;
+	while (valid && offset < size) {
+		if (pending.empty()) {
+			// Whole entries are parsed in place, only a cut off tail is copied
+			const size_t available = size - offset;
+			const size_t length = entrySize(data + offset, available);
+			if (length == INVALID_SIZE) {
+				valid = false;
+				break;
+			}
+			if (length == 0 || length > available) {
+				pending.assign(data + offset, data + size);
+				break;
+			}
+			parse(data + offset, length);
+			offset += length;
+			continue;
+		}
+
+		const size_t length = entrySize(pending.data(), pending.size());
+		if (length == INVALID_SIZE) {
+			valid = false;
+			break;
+		}
+		const size_t wanted = (length ? length : SIZE_PREFIX) - pending.size();
+		const size_t taken = std::min(wanted, size - offset);
+		pending.insert(pending.end(), data + offset, data + offset + taken);
+		offset += taken;
+
+		if (length && pending.size() == length) {
+			parse(pending.data(), length);
+			pending.clear();
+		}
+	}
+	return valid;
+}
@@ -0,0 +1,79 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <functional>
+#include <vector>
+
+// Incremental parser for "logcat -B" output, the raw logger_entry records
+// logd hands out. The stream can be cut anywhere; only the unfinished tail
+// of one entry is kept between feeds, so memory stays bounded by the
+// largest entry however long the log runs.
+class LogcatParser {
+public:
+    enum Priority : uint8_t {
+        Verbose = 2,
+        Debug = 3,
+        Info = 4,
+        Warn = 5,
+        Error = 6,
+        Fatal = 7,
+    };
+
+    // Tag and message point into parser memory and are only valid
+    // during the callback
+    struct Entry {
+        int32_t pid = 0;
+        uint32_t tid = 0;
+        uint32_t sec = 0;
+        uint32_t nsec = 0;
+        uint8_t priority = 0;
+        std::string_view tag;
+        std::string_view message;
+
+        double Time() const;
+    };
+
+    using Sink = std::function<void(const Entry& entry)>;
+
+    LogcatParser(Sink sink);
+    ~LogcatParser();
+    bool Feed(const char* data, size_t size);
+    bool IsValid() const;
+    uint64_t GetEntries() const;
+
+private:
+    size_t entrySize(const char* data, size_t size) const;
+    void parse(const char* data, size_t size);
+
+private:
+    Sink sink;
+    std::vector<char> pending;
+    bool valid;
+    uint64_t entries;
+};
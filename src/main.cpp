@@ -31,6 +31,8 @@ extern "C" __declspec(dllimport) int __stdcall SetConsoleCP(unsigned int);
 #include <QSurfaceFormat>
 
 #include "StartupWindow.hpp"
+#include "adb.hpp"
+#include "adbtrace.hpp"
 
 #include <iostream>
 #include "common.hpp"
@@ -52,11 +54,26 @@ int main(int argc, char *argv[]) {
 #endif
     QSurfaceFormat::setDefaultFormat(format);
 
+    ADB::SetupEnvironment();
+
     QApplication app(argc, argv);
 
-    StartupWindow window;
+    int result = 0;
+    {
+        StartupWindow window;
+
+        window.show();
+
+        result = app.exec();
+    }
 
-    window.show();
+    // GFXR_VIEWER_TRACE=<file.json> dumps the ADB call trace on exit
+    QString tracePath = qEnvironmentVariable("GFXR_VIEWER_TRACE");
+    if (!tracePath.isEmpty()) {
+        if (AdbTrace::getInstance().ExportChromeTrace(tracePath))
+            std::cout << "ADB trace written to " << tracePath.toStdString() << std::endl;
+        std::cout << AdbTrace::getInstance().Summary().toStdString();
+    }
 
-    return app.exec();
+    return result;
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "packagecache.hpp"
+
+#include <QStringList>
+#include <QRegularExpression>
+
+#include <unordered_map>
+#include <cstring>
+
+static const QString FINGERPRINT_SECTION = "__GFXR_FINGERPRINT__";
+static const QString PACKAGE_SECTION = "__GFXR_PACKAGES__";
+static const QString ABI_SECTION = "__GFXR_ABIS__";
+static const QString ACTIVITY_SECTION = "__GFXR_ACTIVITIES__";
+
+QString PackageCache::FingerprintCommand() {
+	// Installs, updates and uninstalls all create or remove a directory here
+	return "stat -c %Y /data/app 2>/dev/null";
+}
+
+QString PackageCache::CollectCommand() {
+	return QString(
+		"echo %1; %2; "
+		"echo %3; pm list packages -3 -f; "
+		"echo %4; dumpsys package packages | grep -E '^  Package \\[|primaryCpuAbi='; "
+		"echo %5; cmd package query-activities --brief --components "
+		"-a android.intent.action.MAIN -c android.intent.category.LAUNCHER")
+		.arg(FINGERPRINT_SECTION, FingerprintCommand(), PACKAGE_SECTION, ABI_SECTION, ACTIVITY_SECTION);
+}
+
+bool PackageCache::Parse(const QString& raw, std::vector<Package>& packages, QString& fingerprint) {
+	static const QRegularExpression packageHeader("^\\s*Package \\[([^\\]]+)\\]");
+	static const QRegularExpression component("^\\s*([\\w.]+)/([\\w.$]+)\\s*$");
+
+	packages.clear();
+	fingerprint.clear();
+	std::unordered_map<std::string, size_t> index;
+	QString section;
+	std::string current;
+
+	for (const QString& rawLine : raw.split('\n')) {
+		const QString line = rawLine.trimmed();
+		if (line == FINGERPRINT_SECTION || line == PACKAGE_SECTION || line == ABI_SECTION || line == ACTIVITY_SECTION) {
+			section = line;
+			continue;
+		}
+
+		if (section == FINGERPRINT_SECTION) {
+			fingerprint += line;
+		}
+		else if (section == PACKAGE_SECTION && line.startsWith("package:")) {
+			// package:/data/app/~~xx==/com.foo-yy==/base.apk=com.foo
+			const qsizetype split = line.lastIndexOf("base.apk=");
+			if (split < 0)
+				continue;
+			Package package;
+			package.name = line.mid(split + strlen("base.apk=")).toStdString();
+			package.libDir = line.mid(strlen("package:"), split - strlen("package:")).toStdString() + "lib/";
+			index[package.name] = packages.size();
+			packages.push_back(package);
+		}
+		else if (section == ABI_SECTION) {
+			QRegularExpressionMatch match = packageHeader.match(rawLine);
+			if (match.hasMatch()) {
+				current = match.captured(1).toStdString();
+				continue;
+			}
+			auto it = index.find(current);
+			if (it == index.end() || !line.startsWith("primaryCpuAbi="))
+				continue;
+			// Hidden system packages repeat later in the dump, keep the first
+			std::string abi = line.mid(strlen("primaryCpuAbi=")).toStdString();
+			if (packages[it->second].abi.empty() && abi != "null")
+				packages[it->second].abi = abi;
+		}
+		else if (section == ACTIVITY_SECTION) {
+			QRegularExpressionMatch match = component.match(line);
+			if (!match.hasMatch())
+				continue;
+			auto it = index.find(match.captured(1).toStdString());
+			if (it != index.end() && packages[it->second].activity.empty())
+				packages[it->second].activity = match.captured(2).toStdString();
+		}
+	}
+
+	return !section.isEmpty();
+}
+
+bool PackageCache::Get(const std::string& serial, const QString& fingerprint, std::vector<Package>& packages) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = entries.find(serial);
+	if (it == entries.end())
+		return false;
+
+	Entry& entry = it->second;
+	if (entry.age.hasExpired(TTL) || entry.fingerprint != fingerprint) {
+		entries.erase(it);
+		return false;
+	}
+
+	packages = entry.packages;
+	return true;
+}
+
+void PackageCache::Put(const std::string& serial, const QString& fingerprint, const std::vector<Package>& packages) {
+	std::lock_guard<std::mutex> lock(mutex);
+	Entry& entry = entries[serial];
+	entry.fingerprint = fingerprint;
+	entry.age.start();
+	entry.packages = packages;
+}
+
+void PackageCache::Invalidate(const std::string& serial) {
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.erase(serial);
+}
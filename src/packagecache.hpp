@@ -0,0 +1,69 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QElapsedTimer>
+
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+
+#include "singleton.hpp"
+
+// Per-device cache of third party package metadata. One batched shell
+// command collects the lib dir, primary ABI and launcher activity of every
+// package, instead of a pm/dumpsys round trip per package. An entry is
+// dropped when it is older than TTL or the /data/app fingerprint changes.
+class PackageCache : public Singleton<PackageCache> {
+public:
+    struct Package {
+        std::string name;
+        std::string libDir;
+        std::string abi;
+        std::string activity;
+    };
+
+    static const qint64 TTL = 5 * 60 * 1000;
+
+    static QString FingerprintCommand();
+    static QString CollectCommand();
+    static bool Parse(const QString& raw, std::vector<Package>& packages, QString& fingerprint);
+
+    bool Get(const std::string& serial, const QString& fingerprint, std::vector<Package>& packages);
+    void Put(const std::string& serial, const QString& fingerprint, const std::vector<Package>& packages);
+    void Invalidate(const std::string& serial);
+
+private:
+    struct Entry {
+        QString fingerprint;
+        QElapsedTimer age;
+        std::vector<Package> packages;
+    };
+
+    std::mutex mutex;
+    std::map<std::string, Entry> entries;
+};
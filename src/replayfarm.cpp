@@ -0,0 +1,266 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "replayfarm.hpp"
+
+#include <QThread>
+#include <QTemporaryDir>
+#include <QDir>
+
+#include <algorithm>
+#include <format>
+
+#include "adb.hpp"
+#include "replaywatcher.hpp"
+#include "common.hpp"
+
+static const char* MEASUREMENT_FILE = "gfxrecon-measurements.json";
+
+ReplayFarm::ReplayFarm(QObject* parent)
+	: QObject(parent), running(0), cancelled(false)
+{
+	pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+}
+
+ReplayFarm::~ReplayFarm() {
+	Cancel();
+	pool.waitForDone();
+}
+
+void ReplayFarm::SetMaxWorkers(int count) {
+	pool.setMaxThreadCount(std::max(1, count));
+}
+
+void ReplayFarm::Enqueue(std::string serial, Job job) {
+	std::lock_guard<std::mutex> lock(mutex);
+	queues[serial].push_back(job);
+	status[serial].jobsTotal++;
+	status[serial].stage = "Queued";
+}
+
+void ReplayFarm::Start() {
+	std::vector<std::string> serials;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (const auto& [serial, queue] : queues)
+			serials.push_back(serial);
+	}
+
+	cancelled = false;
+	running = static_cast<int>(serials.size());
+	for (const std::string& serial : serials)
+		pool.start([this, serial] { runDevice(serial); });
+}
+
+void ReplayFarm::Cancel() {
+	cancelled = true;
+}
+
+bool ReplayFarm::IsFinished() const {
+	return running == 0;
+}
+
+std::map<std::string, ReplayFarm::DeviceStatus> ReplayFarm::GetStatus() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return status;
+}
+
+QString ReplayFarm::Summary() const {
+	QString summary;
+	for (const auto& [serial, device] : GetStatus()) {
+		summary += QString("%1: %2/%3 ").arg(serial.c_str()).arg(device.jobsDone).arg(device.jobsTotal);
+		if (device.finished)
+			summary += device.ok ? QString("done") : "failed, " + device.error;
+		else
+			summary += QString("%1 %2%").arg(device.stage).arg(device.percent);
+		summary += "\n";
+
+		// Repeated runs also get their FPS spread
+		for (const auto& [capture, samples] : device.samples) {
+			if (samples.size() < 2)
+				continue;
+			std::vector<double> fps;
+			for (const ReplayStats::Sample& sample : samples)
+				fps.push_back(sample.fps);
+			const ReplayStats::Summary stats = ReplayStats::Summarize(fps);
+			summary += QString("  %1: %2 fps, 95% CI %3-%4 (%5 runs)\n").arg(capture)
+				.arg(stats.mean, 0, 'f', 2).arg(stats.ciLow, 0, 'f', 2).arg(stats.ciHigh, 0, 'f', 2).arg(stats.runs);
+		}
+	}
+	return summary;
+}
+
+bool ReplayFarm::nextJob(std::string serial, Job& job) {
+	std::lock_guard<std::mutex> lock(mutex);
+	std::deque<Job>& queue = queues[serial];
+	if (queue.empty())
+		return false;
+	job = queue.front();
+	queue.pop_front();
+	return true;
+}
+
+void ReplayFarm::setStage(std::string serial, QString stage, int percent) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		status[serial].stage = stage;
+		status[serial].percent = percent;
+	}
+	emit DeviceUpdated(QString::fromStdString(serial));
+}
+
+void ReplayFarm::finish(std::string serial, bool ok, QString error) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		DeviceStatus& device = status[serial];
+		device.finished = true;
+		device.ok = ok;
+		device.error = error;
+		device.stage = ok ? "Done" : device.stage;
+		queues[serial].clear();
+	}
+	LOGD("Device %s finished: %s", serial.c_str(), ok ? "ok" : error.toStdString().c_str());
+	emit DeviceUpdated(QString::fromStdString(serial));
+
+	if (--running == 0)
+		emit Finished();
+}
+
+bool ReplayFarm::replayOnce(ADB& adb, std::string serial, const Job& job, QString label, ReplayStats::Sample& sample, QString& error) {
+	const QString remote = ADB::GetReplayFile(job.capture.fileName());
+	const QString measurement = ADB::GetReplayFile(MEASUREMENT_FILE);
+	const bool measuring = !job.measurementRange.isEmpty();
+
+	QString args = job.args;
+	if (measuring) {
+		adb.ShellCommandPrivileged(QString("rm -f %1").arg(measurement));
+		args += QString("--measurement-frame-range %1 --measurement-file %2 --quit-after-measurement-range ")
+			.arg(job.measurementRange, measurement);
+	}
+
+	setStage(serial, QString("Launching %1").arg(label), 100);
+	const QString since = adb.GetDeviceTime();
+	if (!adb.LaunchReplay(remote, args)) {
+		error = QString("Failed to launch %1").arg(label);
+		return false;
+	}
+
+	// The next run would force-stop this replay, so wait for it to end
+	ReplayMonitor::Status result = ReplayWatcher(serial, since).Watch([&](const ReplayMonitor::Status& progress) {
+		setStage(serial, QString("Replaying %1, frame %2").arg(label).arg(progress.frames), 100);
+		return !cancelled;
+	});
+	if (cancelled) {
+		adb.ShellCommand(std::format("am force-stop {}", ADB::REPLAY_PACKAGE));
+		error = "Cancelled";
+		return false;
+	}
+
+	// Without a measurement range the FPS summary in the log is the sample
+	sample.frames = result.frames;
+	sample.frameMs = result.avgFrameMs;
+	sample.fps = result.avgFrameMs > 0.0 ? 1000.0 / result.avgFrameMs : 0.0;
+
+	// Quitting after the range can end the process before any summary is
+	// logged, the measurement file is what counts then
+	bool measured = false;
+	if (measuring) {
+		QTemporaryDir dir;
+		const QFileInfo local(QDir(dir.path()).filePath(MEASUREMENT_FILE));
+		measured = dir.isValid() && adb.PullFile(measurement, local) && ReplayStats::ParseMeasurementFile(local.absoluteFilePath(), sample);
+	}
+	if (cancelled) {
+		error = "Cancelled";
+		return false;
+	}
+
+	if (result.state == ReplayMonitor::State::Crashed && !measured) {
+		error = QString("Replay of %1 crashed: %2").arg(label, result.message);
+		return false;
+	}
+	if (result.state != ReplayMonitor::State::Finished && !measured) {
+		error = QString("Lost track of replay of %1").arg(label);
+		return false;
+	}
+	if (measuring && !measured) {
+		error = QString("No measurements from %1").arg(label);
+		return false;
+	}
+	return true;
+}
+
+void ReplayFarm::runDevice(std::string serial) {
+	// One ADB per device, created on the worker so its sockets live there
+	ADB adb;
+	// A cancel aborts the transfer in progress instead of waiting for it
+	adb.SetProgressHandler([this, serial](QString text, int percent) {
+		setStage(serial, text, percent);
+		return !cancelled;
+	});
+
+	setStage(serial, "Connecting", 0);
+	if (!adb.ConnectDevice(serial))
+		return finish(serial, false, "Failed to connect");
+	if (cancelled)
+		return finish(serial, false, "Cancelled");
+
+	setStage(serial, "Installing replay APK", 0);
+	const bool installed = adb.InstallReplayApk();
+	if (cancelled)
+		return finish(serial, false, "Cancelled");
+	if (!installed)
+		return finish(serial, false, "Failed to install replay APK");
+
+	Job job;
+	while (nextJob(serial, job)) {
+		if (cancelled)
+			return finish(serial, false, "Cancelled");
+
+		adb.SetCompression(job.compress);
+		const QString name = job.capture.fileName();
+		setStage(serial, QString("Pushing %1").arg(name), 0);
+		const bool pushed = adb.SyncFile(job.capture, ADB::GetReplayFile(name));
+		if (cancelled)
+			return finish(serial, false, "Cancelled");
+		if (!pushed)
+			return finish(serial, false, QString("Failed to push %1").arg(name));
+
+		const int runs = std::max(1, job.runs);
+		for (int run = 1; run <= runs; run++) {
+			const QString label = runs > 1 ? QString("%1 (run %2/%3)").arg(name).arg(run).arg(runs) : name;
+			ReplayStats::Sample sample;
+			QString error;
+			if (!replayOnce(adb, serial, job, label, sample, error))
+				return finish(serial, false, error);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			status[serial].samples[name].push_back(sample);
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		status[serial].jobsDone++;
+	}
+
+	finish(serial, true, QString());
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QFileInfo>
+#include <QThreadPool>
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "replaystats.hpp"
+
+class ADB;
+
+// Installs the replay APK, pushes captures and launches replays on several
+// devices at once. Each device has its own queue of replay jobs that runs in
+// order on one worker of a bounded pool, with its own ADB connection. A job
+// is done once its replay has finished on the device. A job can replay the
+// same capture several times and keeps one performance sample per run.
+// Per-device progress and failures are collected in GetStatus().
+class ReplayFarm : public QObject {
+    Q_OBJECT
+
+public:
+    struct Job {
+        QFileInfo capture;
+        QString args;
+        bool compress = false;
+        int runs = 1;
+        QString measurementRange;
+    };
+
+    struct DeviceStatus {
+        QString stage;
+        int percent = 0;
+        int jobsDone = 0;
+        int jobsTotal = 0;
+        bool finished = false;
+        bool ok = false;
+        QString error;
+        std::map<QString, std::vector<ReplayStats::Sample>> samples;
+    };
+
+    ReplayFarm(QObject* parent = nullptr);
+    ~ReplayFarm();
+    void SetMaxWorkers(int count);
+    void Enqueue(std::string serial, Job job);
+    void Start();
+    void Cancel();
+    bool IsFinished() const;
+    std::map<std::string, DeviceStatus> GetStatus() const;
+    QString Summary() const;
+
+signals:
+    void DeviceUpdated(QString serial);
+    void Finished();
+
+private:
+    void runDevice(std::string serial);
+    bool replayOnce(ADB& adb, std::string serial, const Job& job, QString label, ReplayStats::Sample& sample, QString& error);
+    bool nextJob(std::string serial, Job& job);
+    void setStage(std::string serial, QString stage, int percent);
+    void finish(std::string serial, bool ok, QString error);
+
+private:
+    QThreadPool pool;
+    mutable std::mutex mutex;
+    std::map<std::string, std::deque<Job>> queues;
+    std::map<std::string, DeviceStatus> status;
+    std::atomic<int> running;
+    std::atomic<bool> cancelled;
+};
\ No newline at end of file
@@ -0,0 +1,196 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "replaymonitor.hpp"
+
+#include <QRegularExpression>
+
+#include <algorithm>
+
+#include "adb.hpp"
+#include "common.hpp"
+
+static const QRegularExpression START_PATTERN(QString("Start proc (\\d+):%1/").arg(QRegularExpression::escape(ADB::REPLAY_PACKAGE)));
+static const QRegularExpression DIED_PATTERN(QString("Process %1 \\(pid (\\d+)\\) has died").arg(QRegularExpression::escape(ADB::REPLAY_PACKAGE)));
+static const QRegularExpression FRAME_PATTERN("\\b[Ff]rame (\\d+)");
+static const QRegularExpression TOTAL_PATTERN("Total time: ([0-9.]+) seconds");
+static const QRegularExpression FPS_PATTERN("FPS: ([0-9.]+) fps, ([0-9.]+) seconds?, (\\d+) frames?");
+
+bool ReplayMonitor::Status::IsDone() const {
+	return state == State::Finished || state == State::Crashed;
+}
+
+QString ReplayMonitor::Status::Summary() const {
+	QString frameTimes;
+	if (frames > 0 && avgFrameMs > 0.0) {
+		frameTimes = maxFrameMs > 0.0
+			? QString("\nFrame time: %1 / %2 / %3 ms (min / avg / max)").arg(minFrameMs, 0, 'f', 2).arg(avgFrameMs, 0, 'f', 2).arg(maxFrameMs, 0, 'f', 2)
+			: QString("\nFrame time: %1 ms avg").arg(avgFrameMs, 0, 'f', 2);
+	}
+
+	switch (state) {
+	case State::Waiting:
+		return "Waiting for replay to start...";
+	case State::Running:
+		return QString("Replaying (pid %1)\nFrames: %2\nElapsed: %3 s").arg(pid).arg(frames).arg(duration, 0, 'f', 1) + frameTimes;
+	case State::Finished:
+		return QString("Replay finished\nFrames: %1\nDuration: %2 s").arg(frames).arg(duration, 0, 'f', 2) + frameTimes;
+	case State::Crashed:
+		return QString("Replay crashed after %1 frames\n%2").arg(frames).arg(message);
+	}
+	return QString();
+}
+
+ReplayMonitor::ReplayMonitor()
+	: parser([this](const LogcatParser::Entry& entry) { onEntry(entry); }),
+	startTime(0.0), lastFrameTime(0.0), lastFrame(0), frameSamples(0), frameSum(0.0), summarySeen(false)
+{
+}
+
+ReplayMonitor::~ReplayMonitor() {
+}
+
+bool ReplayMonitor::Feed(const char* data, size_t size) {
+	return parser.Feed(data, size);
+}
+
+const ReplayMonitor::Status& ReplayMonitor::GetStatus() const {
+	return status;
+}
+
+void ReplayMonitor::onEntry(const LogcatParser::Entry& entry) {
+	if (status.IsDone())
+		return;
+
+	const QString tag = QString::fromUtf8(entry.tag.data(), entry.tag.size());
+	const QString message = QString::fromUtf8(entry.message.data(), entry.message.size());
+	const double time = entry.Time();
+
+	if (status.state == State::Running)
+		status.duration = std::max(status.duration, time - startTime);
+
+	if (tag == "ActivityManager") {
+		QRegularExpressionMatch match = START_PATTERN.match(message);
+		if (match.hasMatch() && status.state == State::Waiting) {
+			onStart(match.captured(1).toInt(), time);
+			return;
+		}
+
+		// Also covers force-stop, which is how a replay gets cancelled
+		match = DIED_PATTERN.match(message);
+		if (match.hasMatch() && status.state == State::Running && match.captured(1).toInt() == status.pid) {
+			if (summarySeen)
+				onEnd(time);
+			else
+				onCrash("Replay process exited before finishing");
+		}
+		return;
+	}
+
+	if (tag == "AndroidRuntime" || tag == "libc" || tag == "DEBUG") {
+		if (status.state != State::Running || entry.priority < LogcatParser::Error)
+			return;
+		if (entry.pid == status.pid || message.contains(ADB::REPLAY_PACKAGE))
+			onCrash(message);
+		return;
+	}
+
+	if (tag != "gfxrecon")
+		return;
+
+	// Without the ActivityManager line the first gfxrecon entry marks the start
+	if (status.state == State::Waiting)
+		onStart(entry.pid, time);
+	if (entry.pid != status.pid)
+		return;
+
+	if (entry.priority >= LogcatParser::Fatal) {
+		onCrash(message);
+		return;
+	}
+
+	QRegularExpressionMatch match = FPS_PATTERN.match(message);
+	if (match.hasMatch()) {
+		// Per frame lines are optional, the summary always has the totals
+		const double seconds = match.captured(2).toDouble();
+		const uint64_t frames = match.captured(3).toULongLong();
+		if (frameSamples == 0 && frames > 0) {
+			status.frames = frames;
+			status.avgFrameMs = seconds * 1000.0 / frames;
+		}
+		summarySeen = true;
+		onEnd(time);
+		return;
+	}
+
+	match = TOTAL_PATTERN.match(message);
+	if (match.hasMatch()) {
+		summarySeen = true;
+		return;
+	}
+
+	match = FRAME_PATTERN.match(message);
+	if (match.hasMatch())
+		onFrame(match.captured(1).toULongLong(), time);
+}
+
+void ReplayMonitor::onStart(int pid, double time) {
+	LOGD("Replay started with pid %d", pid);
+	status.state = State::Running;
+	status.pid = pid;
+	status.message = "Replay started";
+	startTime = time;
+}
+
+void ReplayMonitor::onFrame(uint64_t frame, double time) {
+	if (frame <= lastFrame)
+		return;
+
+	if (lastFrame > 0) {
+		const uint64_t count = frame - lastFrame;
+		const double frameMs = (time - lastFrameTime) * 1000.0 / count;
+		status.minFrameMs = frameSamples ? std::min(status.minFrameMs, frameMs) : frameMs;
+		status.maxFrameMs = std::max(status.maxFrameMs, frameMs);
+		frameSum += frameMs * count;
+		frameSamples += count;
+		status.avgFrameMs = frameSum / frameSamples;
+	}
+
+	lastFrame = frame;
+	lastFrameTime = time;
+	status.frames = frame;
+}
+
+void ReplayMonitor::onEnd(double time) {
+	LOGD("Replay %d finished after %llu frames", status.pid, static_cast<unsigned long long>(status.frames));
+	status.state = State::Finished;
+	status.duration = time - startTime;
+	status.message = "Replay finished";
+}
+
+void ReplayMonitor::onCrash(QString message) {
+	LOGD("Replay %d crashed: %s", status.pid, message.toStdString().c_str());
+	status.state = State::Crashed;
+	status.message = message;
+}
@@ -0,0 +1,80 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+
+#include "logcatparser.hpp"
+
+// Follows the replay app through its logcat: the process start, per frame
+// progress from gfxrecon, the final timing summary and any crash on the way.
+// Only running aggregates are kept, not the entries themselves.
+class ReplayMonitor {
+public:
+    enum class State {
+        Waiting,
+        Running,
+        Finished,
+        Crashed,
+    };
+
+    struct Status {
+        State state = State::Waiting;
+        int pid = 0;
+        uint64_t frames = 0;
+        double duration = 0.0;
+        double minFrameMs = 0.0;
+        double avgFrameMs = 0.0;
+        double maxFrameMs = 0.0;
+        QString message;
+
+        bool IsDone() const;
+        QString Summary() const;
+    };
+
+    ReplayMonitor();
+    ~ReplayMonitor();
+    bool Feed(const char* data, size_t size);
+    const Status& GetStatus() const;
+
+private:
+    void onEntry(const LogcatParser::Entry& entry);
+    void onStart(int pid, double time);
+    void onFrame(uint64_t frame, double time);
+    void onEnd(double time);
+    void onCrash(QString message);
+
+private:
+    LogcatParser parser;
+    Status status;
+    double startTime;
+    double lastFrameTime;
+    uint64_t lastFrame;
+    uint64_t frameSamples;
+    double frameSum;
+    bool summarySeen;
+};
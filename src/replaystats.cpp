@@ -0,0 +1,170 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "replaystats.hpp"
+
+#include <QFile>
+#include <QJsonDocument>
+
+#include <cmath>
+#include <limits>
+
+#include "common.hpp"
+
+// Two-sided 95% critical values of Student's t for 1..30 degrees of freedom
+static const double T_TABLE[] = {
+	12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+	2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+	2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+
+// The measurement file layout has changed between gfxreconstruct releases,
+// so values are looked up by key wherever they are nested
+static QJsonValue findValue(const QJsonObject& object, const QString& key) {
+	if (object.contains(key))
+		return object.value(key);
+	for (auto it = object.begin(); it != object.end(); ++it) {
+		if (!it.value().isObject())
+			continue;
+		QJsonValue value = findValue(it.value().toObject(), key);
+		if (!value.isUndefined())
+			return value;
+	}
+	return QJsonValue(QJsonValue::Undefined);
+}
+
+static double halfWidth(int runs, double variance) {
+	return runs > 1 ? ReplayStats::CriticalT(runs - 1) * std::sqrt(variance / runs) : 0.0;
+}
+
+QJsonObject ReplayStats::Summary::ToJson() const {
+	return QJsonObject{ { "runs", runs }, { "mean", mean }, { "variance", variance } };
+}
+
+ReplayStats::Summary ReplayStats::Summary::FromJson(const QJsonObject& json) {
+	Summary summary;
+	summary.runs = json.value("runs").toInt();
+	summary.mean = json.value("mean").toDouble();
+	summary.variance = json.value("variance").toDouble();
+	const double half = halfWidth(summary.runs, summary.variance);
+	summary.ciLow = summary.mean - half;
+	summary.ciHigh = summary.mean + half;
+	return summary;
+}
+
+double ReplayStats::CriticalT(double dof) {
+	if (dof < 1.0)
+		return std::numeric_limits<double>::infinity();
+	// Past 30 the table is sparse, use the nearest row at or below dof;
+	// rounding down keeps the test on the conservative side
+	const int whole = static_cast<int>(dof);
+	if (whole <= 30)
+		return T_TABLE[whole - 1];
+	if (whole < 40)
+		return T_TABLE[29];
+	if (whole < 60)
+		return 2.021;
+	if (whole < 120)
+		return 2.000;
+	if (whole < 1000)
+		return 1.980;
+	return 1.962;
+}
+
+ReplayStats::Summary ReplayStats::Summarize(const std::vector<double>& values) {
+	Summary summary;
+	summary.runs = static_cast<int>(values.size());
+	if (values.empty())
+		return summary;
+
+	// Welford's update, stable for long runs of similar values
+	double mean = 0.0;
+	double m2 = 0.0;
+	for (size_t i = 0; i < values.size(); i++) {
+		const double delta = values[i] - mean;
+		mean += delta / (i + 1);
+		m2 += delta * (values[i] - mean);
+	}
+
+	summary.mean = mean;
+	summary.variance = values.size() > 1 ? m2 / (values.size() - 1) : 0.0;
+	const double half = halfWidth(summary.runs, summary.variance);
+	summary.ciLow = mean - half;
+	summary.ciHigh = mean + half;
+	return summary;
+}
+
+ReplayStats::Comparison ReplayStats::Compare(const Summary& baseline, const Summary& current, double minChange) {
+	Comparison comparison;
+	if (baseline.runs == 0 || current.runs == 0 || baseline.mean == 0.0)
+		return comparison;
+
+	comparison.change = (current.mean - baseline.mean) / baseline.mean;
+
+	const double a = baseline.variance / baseline.runs;
+	const double b = current.variance / current.runs;
+	const double error = std::sqrt(a + b);
+	if (error == 0.0) {
+		// Noise free runs, e.g. a fake device, only the change itself counts
+		comparison.t = comparison.change == 0.0 ? 0.0 : std::copysign(std::numeric_limits<double>::infinity(), comparison.change);
+		comparison.critical = 0.0;
+	}
+	else {
+		// Welch-Satterthwaite degrees of freedom
+		const double denominator = (baseline.runs > 1 ? a * a / (baseline.runs - 1) : 0.0) + (current.runs > 1 ? b * b / (current.runs - 1) : 0.0);
+		const double dof = denominator > 0.0 ? (a + b) * (a + b) / denominator : 0.0;
+		comparison.t = (current.mean - baseline.mean) / error;
+		comparison.critical = CriticalT(dof);
+	}
+
+	comparison.significant = std::abs(comparison.t) > comparison.critical && std::abs(comparison.change) >= minChange;
+	return comparison;
+}
+
+bool ReplayStats::ParseMeasurementFile(const QString& path, Sample& sample) {
+	QFile f(path);
+	if (!f.open(QIODevice::ReadOnly))
+		return false;
+
+	QJsonParseError error;
+	const QJsonDocument document = QJsonDocument::fromJson(f.readAll(), &error);
+	if (error.error != QJsonParseError::NoError || !document.isObject()) {
+		LOGD("Bad measurement file %s: %s", path.toStdString().c_str(), error.errorString().toStdString().c_str());
+		return false;
+	}
+
+	const QJsonObject root = document.object();
+	const double fps = findValue(root, "fps").toDouble();
+	if (fps <= 0.0)
+		return false;
+
+	sample.fps = fps;
+	sample.frameMs = 1000.0 / fps;
+	const QJsonValue count = findValue(root, "frame_count");
+	if (count.isDouble())
+		sample.frames = static_cast<uint64_t>(count.toDouble());
+	else if (findValue(root, "end_frame").isDouble())
+		sample.frames = static_cast<uint64_t>(findValue(root, "end_frame").toDouble() - findValue(root, "start_frame").toDouble());
+	return true;
+}
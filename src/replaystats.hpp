@@ -0,0 +1,67 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QJsonObject>
+
+#include <cstdint>
+#include <vector>
+
+// Statistics over repeated replays of one capture on one device. Every run
+// gives a sample; the runs are summarized with a 95% confidence interval
+// and compared against a stored baseline with Welch's t-test, which does
+// not assume both sets of runs are equally noisy.
+class ReplayStats {
+public:
+    struct Sample {
+        double fps = 0.0;
+        double frameMs = 0.0;
+        uint64_t frames = 0;
+    };
+
+    struct Summary {
+        int runs = 0;
+        double mean = 0.0;
+        double variance = 0.0;
+        double ciLow = 0.0;
+        double ciHigh = 0.0;
+
+        QJsonObject ToJson() const;
+        static Summary FromJson(const QJsonObject& json);
+    };
+
+    struct Comparison {
+        double change = 0.0;
+        double t = 0.0;
+        double critical = 0.0;
+        bool significant = false;
+    };
+
+    static Summary Summarize(const std::vector<double>& values);
+    static Comparison Compare(const Summary& baseline, const Summary& current, double minChange);
+    static double CriticalT(double dof);
+    static bool ParseMeasurementFile(const QString& path, Sample& sample);
+};
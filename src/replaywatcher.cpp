@@ -0,0 +1,113 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "replaywatcher.hpp"
+
+#include <QTcpSocket>
+#include <QtEndian>
+
+#include "adbclient.hpp"
+#include "common.hpp"
+
+// Idle ticks let a watch notice cancellation while the replay is quiet
+static const int POLL_MS = 250;
+static const int SHELL_HEADER_SIZE = 5;
+
+static QString logcatCommand(QString since) {
+	QString cmd = "logcat -B -b main,system,crash";
+	if (!since.isEmpty())
+		cmd += QString(" -T %1").arg(since);
+	return cmd + " gfxrecon:V ActivityManager:I libc:F DEBUG:F AndroidRuntime:E '*:S'";
+}
+
+ReplayWatcher::ReplayWatcher(std::string serial, QString since)
+	: serial(serial), since(since), cancelled(false)
+{
+}
+
+ReplayWatcher::~ReplayWatcher() {
+}
+
+ReplayMonitor::Status ReplayWatcher::GetStatus() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return status;
+}
+
+void ReplayWatcher::Cancel() {
+	cancelled = true;
+}
+
+bool ReplayWatcher::update(const ReplayMonitor::Status& current, const Callback& callback) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		status = current;
+	}
+	if (callback && !callback(current))
+		return false;
+	return !cancelled && !current.IsDone();
+}
+
+ReplayMonitor::Status ReplayWatcher::Watch(Callback callback) {
+	ReplayMonitor monitor;
+	auto socket = AdbClient().OpenService(serial, "shell,v2,raw:" + logcatCommand(since));
+	if (!socket) {
+		LOGD("Failed to open logcat on %s", serial.c_str());
+		return monitor.GetStatus();
+	}
+
+	// Shell packets are taken off the socket without blocking so idle
+	// ticks keep coming while logcat has nothing to say
+	QByteArray pending;
+	bool open = true;
+	while (open && update(monitor.GetStatus(), callback)) {
+		if (socket->bytesAvailable() == 0 && !socket->waitForReadyRead(POLL_MS)) {
+			open = socket->state() == QAbstractSocket::ConnectedState;
+			continue;
+		}
+		pending += socket->readAll();
+
+		qsizetype offset = 0;
+		while (open && pending.size() - offset >= SHELL_HEADER_SIZE) {
+			const char id = pending[offset];
+			const quint32 length = qFromLittleEndian<quint32>(pending.constData() + offset + 1);
+			if (pending.size() - offset - SHELL_HEADER_SIZE < static_cast<qsizetype>(length))
+				break;
+
+			const char* data = pending.constData() + offset + SHELL_HEADER_SIZE;
+			if (id == AdbClient::ShellStdout && !monitor.Feed(data, length)) {
+				LOGD("Corrupt logcat stream from %s", serial.c_str());
+				open = false;
+			}
+			else if (id == AdbClient::ShellExit) {
+				LOGD("logcat on %s exited", serial.c_str());
+				open = false;
+			}
+			offset += SHELL_HEADER_SIZE + length;
+		}
+		pending.remove(0, offset);
+	}
+
+	update(monitor.GetStatus(), nullptr);
+	return monitor.GetStatus();
+}
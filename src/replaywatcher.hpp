@@ -0,0 +1,60 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+#include "replaymonitor.hpp"
+
+// Streams the device log from a given device time on as binary logcat over
+// an adb shell v2 session, and feeds it to a ReplayMonitor until the replay
+// finishes, crashes or the watch is cancelled. Watch() blocks, GetStatus()
+// and Cancel() may be called from any thread meanwhile.
+class ReplayWatcher {
+public:
+    // Called on every status change and idle tick, return false to stop
+    using Callback = std::function<bool(const ReplayMonitor::Status& status)>;
+
+    ReplayWatcher(std::string serial, QString since);
+    ~ReplayWatcher();
+    ReplayMonitor::Status Watch(Callback callback = nullptr);
+    ReplayMonitor::Status GetStatus() const;
+    void Cancel();
+
+private:
+    bool update(const ReplayMonitor::Status& current, const Callback& callback);
+
+private:
+    std::string serial;
+    QString since;
+    mutable std::mutex mutex;
+    ReplayMonitor::Status status;
+    std::atomic<bool> cancelled;
+};
@@ -49,7 +49,6 @@ ProgressBar::ProgressBar(QString text) {
     bar->setLabelText(text);
     bar->setValue(0);
     bar->show();
-    QCoreApplication::processEvents();
 }
 
 ProgressBar::~ProgressBar() {
@@ -58,11 +57,13 @@ ProgressBar::~ProgressBar() {
 
 void ProgressBar::update(int percent) {
     bar->setValue(percent);
-    QCoreApplication::processEvents();
+}
+
+void ProgressBar::setText(QString text) {
+    bar->setLabelText(text);
 }
 
 void ProgressBar::close() {
     bar->hide();
     bar->deleteLater();
-    QCoreApplication::processEvents();
 }
\ No newline at end of file
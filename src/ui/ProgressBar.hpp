@@ -28,11 +28,14 @@
 
 class QWidget;
 
+// A modal progress dialog. It only repaints from the event loop, so the
+// work it shows runs elsewhere and reports back through signals.
 class ProgressBar {
 public:
     ProgressBar(QString text);
     ~ProgressBar();
     void update(int percent);
+    void setText(QString text);
     void close();
 
 private:
@@ -23,15 +23,26 @@
  *******************************************************************************/
 
 #include "StartupWindow.hpp"
+#include "blockdecompressor.hpp"
 
 #include <QFileDialog>
 #include <QStandardPaths>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrent>
 
 #include <filesystem>
+#include <climits>
 #include "common.hpp"
 
+// Rows from the device tracker carry the serial apart from the display text
+static std::string SerialOf(const QModelIndex& index) {
+    QVariant serial = index.data(DeviceTracker::SerialRole);
+    return (serial.isValid() ? serial : index.data(Qt::DisplayRole)).toString().toStdString();
+}
+
 StartupWindow::StartupWindow(QWidget* parent)
-    : QWidget(parent), ui(new Ui::StartupWindow), m_eCurrentPage(Page::Startup), m_ListModel(this)
+    : QWidget(parent), ui(new Ui::StartupWindow), m_eCurrentPage(Page::Startup), m_AdbAsync(adb), m_bBusy(false), m_ListModel(this), m_DeviceTracker(this), m_FollowTimer(this), m_ReplayTimer(this)
 {
     ui->setupUi(this);
     ui->background = new Background(ui->centralwidget);
@@ -47,6 +58,10 @@ StartupWindow::StartupWindow(QWidget* parent)
     ui->SelectListView->raise();
     ui->InputLineEdit->raise();
     ui->RemoveUnsupportedBox->raise();
+    ui->CompressTransferBox->raise();
+    ui->StatusLabel->raise();
+    ui->FrameSlider->raise();
+    ui->CallTreeView->raise();
 
     ui->NextButton->hide();
     ui->BackButton->hide();
@@ -54,6 +69,10 @@ StartupWindow::StartupWindow(QWidget* parent)
     ui->SelectListView->hide();
     ui->InputLineEdit->hide();
     ui->RemoveUnsupportedBox->hide();
+    ui->CompressTransferBox->hide();
+    ui->StatusLabel->hide();
+    ui->FrameSlider->hide();
+    ui->CallTreeView->hide();
 
     connect(ui->CloseButton, &QPushButton::clicked, this, &QWidget::close);
     connect(ui->RecordButton, &QPushButton::clicked, this, &StartupWindow::OnRecordButtonClicked);
@@ -63,13 +82,33 @@ StartupWindow::StartupWindow(QWidget* parent)
     connect(ui->BackButton, &QPushButton::clicked, this, &StartupWindow::OnBackButtonClicked);
     connect(ui->FileSelectButton, &QPushButton::clicked, this, &StartupWindow::OnFileSelectButtonClicked);
     connect(ui->SelectListView, &QListView::doubleClicked, this, &StartupWindow::OnNextButtonClicked);
+    connect(ui->InputLineEdit, &QLineEdit::returnPressed, this, &StartupWindow::OnNextButtonClicked);
+    connect(ui->FrameSlider, &QSlider::valueChanged, this, &StartupWindow::OnFrameSliderMoved);
+    connect(ui->CallTreeView, &QTreeView::collapsed, this, &StartupWindow::OnCallTreeCollapsed);
+    connect(&m_FollowTimer, &QTimer::timeout, this, &StartupWindow::OnFollowTimeout);
+    connect(&m_ReplayTimer, &QTimer::timeout, this, &StartupWindow::OnReplayTimeout);
+    connect(&m_ListWatcher, &QFutureWatcher<std::string>::resultsReadyAt, this, &StartupWindow::OnListResultsReady);
+    connect(&m_AdbAsync, &AdbAsync::TransferProgress, this, &StartupWindow::OnTransferProgress);
+    connect(&m_DeviceTracker, &DeviceTracker::TrackingChanged, this, &StartupWindow::OnTrackingChanged);
+
+    m_FollowTimer.setInterval(500);
+    m_ReplayTimer.setInterval(500);
 
     ui->SelectListView->setModel(&m_ListModel);
+    m_DeviceTracker.Start();
 
     setWindowFlags(Qt::FramelessWindowHint | Qt::Window);
 }
 
 StartupWindow::~StartupWindow() {
+    m_ListWatcher.cancel();
+    StopFollowing().waitForFinished();
+    if (m_ReplayWatcher)
+        m_ReplayWatcher->Cancel();
+    m_ReplayFuture.waitForFinished();
+    m_CallTableStop.request_stop();
+    m_CallTableFuture.waitForFinished();
+    ui->CallTreeView->setModel(nullptr);
     delete ui->background;
     delete ui;
 }
@@ -98,11 +137,20 @@ void StartupWindow::FlipPage(Page page) {
     ui->SelectListView->hide();
     ui->InputLineEdit->hide();
     ui->RemoveUnsupportedBox->hide();
+    ui->CompressTransferBox->hide();
+    ui->StatusLabel->hide();
+    ui->FrameSlider->hide();
+    ui->CallTreeView->hide();
 
     ui->NextButton->setText("Next");
+    ui->StatusLabel->setText("");
+    m_ListWatcher.cancel();
     ui->InputLineEdit->setText("");
     ui->InputLineEdit->setPlaceholderText("");
     ui->RemoveUnsupportedBox->setChecked(false);
+    ui->CompressTransferBox->setChecked(false);
+    ui->SelectListView->setSelectionMode(QAbstractItemView::SingleSelection);
+    SetListModel(&m_ListModel);
 
     switch (page)
     {
@@ -117,24 +165,15 @@ void StartupWindow::FlipPage(Page page) {
         case StartupWindow::Page::Replay:
         {
             ui->InputLineEdit->setPlaceholderText("Connect to new device");
+            if (page == Page::Replay)
+                ui->SelectListView->setSelectionMode(QAbstractItemView::ExtendedSelection);
 
             ui->NextButton->show();
             ui->BackButton->show();
             ui->SelectListView->show();
             ui->InputLineEdit->show();
 
-            QStringList rows;
-            m_ListModel.setStringList(rows);
-
-            std::vector<std::string> devices = adb.GetDevices();
-            LOGD("ADB device num %d", devices.size());
-            for (std::string device : devices)
-                LOGD("    %s", device.c_str());
-
-            for (std::string device : devices) {
-                rows << QString(QString::fromStdString(device));
-            }
-            m_ListModel.setStringList(rows);
+            LoadDevices();
 
             break;
         }
@@ -147,16 +186,7 @@ void StartupWindow::FlipPage(Page page) {
             ui->SelectListView->show();
             ui->InputLineEdit->show();
 
-            QStringList rows;
-            m_ListModel.setStringList(rows);
-
-            std::vector<std::string> packages = adb.GetPackages();
-            LOGD("package num %d", packages.size());
-            for (std::string package : packages) {
-                LOGD("    %s", package.c_str());
-                rows << QString(QString::fromStdString(package));
-            }
-            m_ListModel.setStringList(rows);
+            LoadList(m_AdbAsync.GetPackages());
 
             break;
         }
@@ -180,6 +210,67 @@ void StartupWindow::FlipPage(Page page) {
             ui->FileSelectButton->show();
             ui->InputLineEdit->show();
             ui->RemoveUnsupportedBox->show();
+            ui->CompressTransferBox->show();
+
+            break;
+        }
+        case StartupWindow::Page::Recording:
+        {
+            ui->NextButton->setText("Stop");
+            ui->StatusLabel->setText("Waiting for capture...");
+
+            ui->NextButton->show();
+            ui->BackButton->show();
+            ui->StatusLabel->show();
+
+            break;
+        }
+        case StartupWindow::Page::FarmStatus:
+        {
+            ui->NextButton->setText("Cancel");
+
+            ui->NextButton->show();
+            ui->StatusLabel->show();
+
+            break;
+        }
+        case StartupWindow::Page::Replaying:
+        {
+            ui->NextButton->setText("Stop");
+            ui->StatusLabel->setText("Waiting for replay to start...");
+
+            ui->NextButton->show();
+            ui->StatusLabel->show();
+
+            break;
+        }
+        case StartupWindow::Page::Capture:
+        {
+            ui->NextButton->setText("Frames");
+
+            if (m_Capture && !m_Capture->GetFrames().empty())
+                ui->NextButton->show();
+            ui->BackButton->show();
+            ui->StatusLabel->show();
+
+            break;
+        }
+        case StartupWindow::Page::Frame:
+        {
+            const int frames = static_cast<int>(std::min<size_t>(m_Capture->GetFrames().size(), INT_MAX));
+            ui->NextButton->setText("Go");
+            ui->InputLineEdit->setPlaceholderText(QString("Frame 1 - %1, or a filter like vkCmdDraw* instanceCount>1").arg(frames));
+            {
+                QSignalBlocker blocker(ui->FrameSlider);
+                ui->FrameSlider->setRange(1, frames);
+                ui->FrameSlider->setValue(1);
+            }
+
+            ui->NextButton->show();
+            ui->BackButton->show();
+            ui->InputLineEdit->show();
+            ui->FrameSlider->show();
+            ui->CallTreeView->show();
 
             break;
         }
@@ -208,6 +299,9 @@ void StartupWindow::OnFileSelectButtonClicked() {
 
 void StartupWindow::OnNextButtonClicked() {
     LOGD("Next button clicked");
+    if (m_bBusy)
+        return;
+
     switch (m_eCurrentPage) {
         case StartupWindow::Page::Record:
         case StartupWindow::Page::Replay:
@@ -220,21 +314,42 @@ void StartupWindow::OnNextButtonClicked() {
                 LOGD("Input new device %s", serial.c_str());
             }
             else if (idx.isValid()) {
-                serial = idx.data(Qt::DisplayRole).toString().toStdString();
+                serial = SerialOf(idx);
                 LOGD("Selected device is %s", serial.c_str());
+
+                QVariant state = idx.data(DeviceTracker::StateRole);
+                if (state.isValid() && state.toString() != "device") {
+                    LOGW("Device %s is %s", serial.c_str(), state.toString().toStdString().c_str());
+                    break;
+                }
             }
             else {
                 LOGD("No device is selected");
                 break;
             }
 
-            if (adb.ConnectDevice(serial)) {
-                LOGD("Connected with %s", serial.c_str());
-                FlipPage(ENUM_NEXT(m_eCurrentPage));
-            }
-            else {
-                LOGW("Failed to connected with %s", serial.c_str());
+            // Several devices selected on the Replay page replay on all of them
+            m_vecSelectedSerials.clear();
+            if (ui->InputLineEdit->text().isEmpty()) {
+                for (const QModelIndex& selected : ui->SelectListView->selectionModel()->selectedIndexes())
+                    m_vecSelectedSerials.push_back(SerialOf(selected));
             }
+            if (m_vecSelectedSerials.size() > 1)
+                serial = m_vecSelectedSerials.front();
+
+            SetBusy(true);
+            m_AdbAsync.Run([serial](ADB& adb) {
+                return adb.ConnectDevice(serial);
+            }).then(this, [this, serial](bool connected) {
+                SetBusy(false);
+                if (connected) {
+                    LOGD("Connected with %s", serial.c_str());
+                    FlipPage(ENUM_NEXT(m_eCurrentPage));
+                }
+                else {
+                    LOGW("Failed to connected with %s", serial.c_str());
+                }
+            });
 
             break;
         }
@@ -250,31 +365,132 @@ void StartupWindow::OnNextButtonClicked() {
 
             m_strSelectedPackage = package;
             m_strSelectedActivity = ui->InputLineEdit->text().toStdString();
-            if (m_strSelectedActivity.empty()) {
-                std::string cmd = std::format("cmd package resolve-activity "
-                    "-a android.intent.action.MAIN "
-                    "-c android.intent.category.LAUNCHER "
-                    "--brief {} | tail -n 1 | cut -d '/' -f2", m_strSelectedPackage);
-                m_strSelectedActivity = adb.ShellCommand(cmd);
-            }
 
-            LOGD("Selected package is %s", m_strSelectedPackage.c_str());
-            LOGD("Selected activity is %s", m_strSelectedActivity.c_str());
+            std::string activity = m_strSelectedActivity;
 
-            FlipPage(Page::Option);
+            SetBusy(true);
+            m_AdbAsync.Run([package, activity](ADB& adb) {
+                return activity.empty() ? adb.GetLauncherActivity(package) : activity;
+            }).then(this, [this](std::string activity) {
+                SetBusy(false);
+                m_strSelectedActivity = activity;
+
+                LOGD("Selected package is %s", m_strSelectedPackage.c_str());
+                LOGD("Selected activity is %s", m_strSelectedActivity.c_str());
+
+                FlipPage(Page::Option);
+            });
 
             break;
         }
         case StartupWindow::Page::Option:
         {
-            if (!adb.PushRecordLayer(m_strSelectedPackage))
+            std::string package = m_strSelectedPackage;
+            std::string activity = m_strSelectedActivity;
+            std::string args = ui->InputLineEdit->text().toStdString();
+
+            QDir downloads(QStandardPaths::writableLocation(QStandardPaths::DownloadLocation));
+            QString localCaptureFilePath = downloads.filePath(QString("%1.gfxr").arg(package.c_str()));
+
+            SetBusy(true);
+            m_AdbAsync.Run([package, activity, args, localCaptureFilePath](ADB& adb) -> std::shared_ptr<CaptureFollower> {
+                if (!adb.PushRecordLayer(package))
+                    return nullptr;
+
+                adb.SetRecordProp(package);
+                adb.ShellCommand(std::format("am force-stop {}", package));
+                adb.ShellCommand(std::format("am start -n {}/{} {}", package, activity, args));
+
+                return adb.FollowCapture(package, localCaptureFilePath);
+            }).then(this, [this](std::shared_ptr<CaptureFollower> follower) {
+                SetBusy(false);
+                CloseProgress();
+                if (!follower)
+                    return;
+
+                m_CaptureFollower = follower;
+                m_FollowTimer.start();
+                FlipPage(Page::Recording);
+            });
+
+            break;
+        }
+        case StartupWindow::Page::Recording:
+        {
+            std::string package = m_strSelectedPackage;
+            m_AdbAsync.Run([package](ADB& adb) {
+                adb.ShellCommand(std::format("am force-stop {}", package));
+            });
+
+            SetBusy(true);
+            StopFollowing().then(this, [this]() {
+                SetBusy(false);
+                FlipPage(Page::Startup);
+            });
+
+            break;
+        }
+        case StartupWindow::Page::FarmStatus:
+        {
+            if (m_ReplayFarm && !m_ReplayFarm->IsFinished()) {
+                m_ReplayFarm->Cancel();
                 break;
+            }
 
-            adb.SetRecordProp(m_strSelectedPackage);
-            std::string args = ui->InputLineEdit->text().toStdString();
-            adb.ShellCommand(std::format("am force-stop {}", m_strSelectedPackage));
-            adb.ShellCommand(std::format("am start -n {}/{} {}", m_strSelectedPackage, m_strSelectedActivity, args));
+            m_ReplayFarm.reset();
+            FlipPage(Page::Startup);
+
+            break;
+        }
+        case StartupWindow::Page::Replaying:
+        {
+            if (m_ReplayFuture.isRunning()) {
+                m_ReplayWatcher->Cancel();
+                m_AdbAsync.Run([](ADB& adb) {
+                    adb.ShellCommand(std::format("am force-stop {}", ADB::REPLAY_PACKAGE));
+                });
+                break;
+            }
+
+            m_ReplayWatcher.reset();
+            FlipPage(Page::Startup);
+
+            break;
+        }
+        case StartupWindow::Page::Capture:
+        {
+            m_CallTreeModel = std::make_unique<CallTreeModel>(m_Capture);
+            ui->CallTreeView->setModel(m_CallTreeModel.get());
+            m_SeekedFrame = QModelIndex();
+            FlipPage(Page::Frame);
+            SeekFrame(0);
+            break;
+        }
+        case StartupWindow::Page::Frame:
+        {
+            // Frames are numbered from 1 in the UI, like in the replay tools;
+            // anything else filters the calls, nothing clears the filter
+            const QString text = ui->InputLineEdit->text().trimmed();
+            bool ok = false;
+            const qulonglong frame = text.toULongLong(&ok);
+            if (text.isEmpty() && m_CallTreeModel->IsFiltered()) {
+                m_SeekedFrame = QModelIndex();
+                m_CallTreeModel->ClearFilter();
+                SeekFrame(ui->FrameSlider->value() - 1);
+                break;
+            }
+            if (!ok && !text.isEmpty()) {
+                FilterCalls(text);
+                break;
+            }
+            if (!ok || frame < 1 || frame > m_Capture->GetFrames().size()) {
+                ui->InputLineEdit->selectAll();
+                break;
+            }
 
+            QSignalBlocker blocker(ui->FrameSlider);
+            ui->FrameSlider->setValue(static_cast<int>(std::min<qulonglong>(frame, INT_MAX)));
+            SeekFrame(frame - 1);
             break;
         }
         case StartupWindow::Page::FileSelect:
@@ -282,7 +498,7 @@ void StartupWindow::OnNextButtonClicked() {
             QString localReplayFilePath = ui->InputLineEdit->text();
             QFileInfo localReplayFilePathInfo(localReplayFilePath);
             QString replayFileName = localReplayFilePathInfo.fileName();
-            QString remoteReplayFilePath = "/data/user/0/com.lunarg.gfxreconstruct.replay/files/" + replayFileName;
+            QString remoteReplayFilePath = ADB::GetReplayFile(replayFileName);
 
             if (localReplayFilePath.isEmpty()) {
                 LOGW("No replay file is selected");
@@ -294,38 +510,42 @@ void StartupWindow::OnNextButtonClicked() {
                 break;
             }
 
-            if (!adb.InstallReplayApk()) {
-                break;
-            }
+            QString args = "";
+            if (ui->RemoveUnsupportedBox->isChecked())
+                args += "--remove-unsupported ";
 
-            if (!localReplayFilePathInfo.isFile()) {
-                LOGW("Replay file %s not exists", localReplayFilePath.toStdString().c_str());
+            if (m_vecSelectedSerials.size() > 1) {
+                StartReplayFarm(localReplayFilePathInfo, args);
                 break;
             }
 
-            if (!adb.AlreadyUploaded(localReplayFilePathInfo, remoteReplayFilePath)) {
-                if (!adb.PushFile(localReplayFilePathInfo, remoteReplayFilePath)) {
-                    LOGW("Failed to push replay file");
-                    break;
-                }
-            }
-            else {
-                LOGD("Replay file %s exists", replayFileName.toStdString().c_str());
-            }
+            bool compress = ui->CompressTransferBox->isChecked();
 
-            adb.ShellCommand("am force-stop com.lunarg.gfxreconstruct.replay");
+            SetBusy(true);
+            m_AdbAsync.Run([localReplayFilePathInfo, remoteReplayFilePath, args, compress](ADB& adb) -> std::shared_ptr<ReplayWatcher> {
+                if (!adb.InstallReplayApk())
+                    return nullptr;
 
-            QString args = "";
-            if (ui->RemoveUnsupportedBox->isChecked())
-                args += "--remove-unsupported ";
+                adb.SetCompression(compress);
+                if (!adb.SyncFile(localReplayFilePathInfo, remoteReplayFilePath)) {
+                    LOGW("Failed to push replay file");
+                    return nullptr;
+                }
 
-            QString cmd = QString(
-                "am start -n \"com.lunarg.gfxreconstruct.replay/android.app.NativeActivity\""
-                " -a android.intent.action.MAIN -c android.intent.category.LAUNCHER"
-                " --es \"args\" \"%1%2\"").arg(args, remoteReplayFilePath);
-            adb.ShellCommand(cmd);
+                // Log entries from before the launch belong to an earlier replay
+                QString since = adb.GetDeviceTime();
+                if (!adb.LaunchReplay(remoteReplayFilePath, args)) {
+                    LOGW("Failed to launch replay");
+                    return nullptr;
+                }
 
-            FlipPage(Page::Startup);
+                return std::make_shared<ReplayWatcher>(adb.GetSerial(), since);
+            }).then(this, [this](std::shared_ptr<ReplayWatcher> watcher) {
+                SetBusy(false);
+                CloseProgress();
+                if (watcher)
+                    WatchReplay(watcher);
+            });
 
             break;
         }
@@ -338,6 +558,9 @@ void StartupWindow::OnNextButtonClicked() {
 
 void StartupWindow::OnBackButtonClicked() {
     LOGD("Back button clicked");
+    if (m_bBusy)
+        return;
+
     switch (m_eCurrentPage) {
         case StartupWindow::Page::Record:
         case StartupWindow::Page::Replay:
@@ -352,6 +575,27 @@ void StartupWindow::OnBackButtonClicked() {
             FlipPage(ENUM_PREV(m_eCurrentPage));
             break;
         }
+        case StartupWindow::Page::Recording:
+        {
+            StopFollowing();
+            FlipPage(Page::Option);
+            break;
+        }
+        case StartupWindow::Page::Capture:
+        {
+            m_Capture.reset();
+            FlipPage(Page::Startup);
+            break;
+        }
+        case StartupWindow::Page::Frame:
+        {
+            ui->CallTreeView->setModel(nullptr);
+            m_CallTreeModel.reset();
+            m_CallTable.reset();
+            FlipPage(Page::Capture);
+            ShowCaptureSummary();
+            break;
+        }
         default:
         {
             LOGE("Unknown page %d when clicking back button", m_eCurrentPage);
@@ -359,9 +603,293 @@ void StartupWindow::OnBackButtonClicked() {
     }
 }
 
+void StartupWindow::OnFollowTimeout() {
+    // Skip this tick if the previous poll is still pulling
+    if (!m_CaptureFollower || m_FollowFuture.isRunning())
+        return;
+
+    std::shared_ptr<CaptureFollower> follower = m_CaptureFollower;
+    m_FollowFuture = m_AdbAsync.Run([follower](ADB&) {
+        if (!follower->Poll())
+            LOGD("Failed to follow capture, retrying on next poll");
+        return follower->GetProgress();
+    });
+    m_FollowFuture.then(this, [this](CaptureFollower::Progress progress) {
+        ShowFollowProgress(progress);
+    });
+}
+
+void StartupWindow::ShowFollowProgress(const CaptureFollower::Progress& progress) {
+    const BlockParser::Stats& stats = progress.stats;
+    if (!m_CaptureFollower || m_eCurrentPage != Page::Recording || !stats.headerValid)
+        return;
+
+    const quint64 avgFrameBytes = stats.frames ? stats.frameBytes / stats.frames : 0;
+    ui->StatusLabel->setText(QString(
+        "Capture %1\n"
+        "Frames: %2\n"
+        "Blocks: %3 (%4 calls)\n"
+        "Size: %5 MB\n"
+        "Bytes per frame: %6 KB avg, %7 KB last\n"
+        "Follow budget: %8 MB/s")
+        .arg(m_CaptureFollower->GetLocalPath())
+        .arg(stats.frames)
+        .arg(stats.blocks)
+        .arg(stats.functionCalls)
+        .arg(stats.bytes / 1e6, 0, 'f', 1)
+        .arg(avgFrameBytes / 1024)
+        .arg(stats.lastFrameBytes / 1024)
+        .arg(progress.budget / 1e6, 0, 'f', 1));
+}
+
+QFuture<void> StartupWindow::StopFollowing() {
+    m_FollowTimer.stop();
+
+    // Drain on the worker, after any poll still in flight
+    std::shared_ptr<CaptureFollower> follower = std::move(m_CaptureFollower);
+    return m_AdbAsync.Run([follower](ADB&) {
+        if (follower)
+            follower->Finish();
+    });
+}
+
+void StartupWindow::SetListModel(QAbstractItemModel* model) {
+    if (ui->SelectListView->model() == model)
+        return;
+
+    // The view does not delete the selection model it made for the old model
+    QItemSelectionModel* selection = ui->SelectListView->selectionModel();
+    ui->SelectListView->setModel(model);
+    delete selection;
+}
+
+void StartupWindow::LoadDevices() {
+    if (m_DeviceTracker.IsTracking()) {
+        SetListModel(&m_DeviceTracker);
+        return;
+    }
+
+    // No server to track yet, listing through ADB also starts one
+    SetListModel(&m_ListModel);
+    LoadList(m_AdbAsync.GetDevices());
+}
+
+void StartupWindow::OnTrackingChanged(bool tracking) {
+    LOGD("Device tracking %s", tracking ? "started" : "stopped");
+    if (m_eCurrentPage == Page::Record || m_eCurrentPage == Page::Replay) {
+        m_ListWatcher.cancel();
+        LoadDevices();
+    }
+}
+
+void StartupWindow::LoadList(QFuture<std::string> future) {
+    m_ListWatcher.cancel();
+    m_ListModel.setStringList(QStringList());
+    m_ListWatcher.setFuture(future);
+}
+
+void StartupWindow::OnListResultsReady(int begin, int end) {
+    // Append in place, resetting the model would drop the selection
+    m_ListModel.insertRows(begin, end - begin);
+    for (int i = begin; i < end; i++)
+        m_ListModel.setData(m_ListModel.index(i), QString::fromStdString(m_ListWatcher.resultAt(i)));
+}
+
+void StartupWindow::OnTransferProgress(QString text, int percent) {
+    if (!m_ProgressBar)
+        m_ProgressBar = std::make_unique<ProgressBar>(text);
+    m_ProgressBar->setText(text);
+    m_ProgressBar->update(percent);
+}
+
+void StartupWindow::CloseProgress() {
+    m_ProgressBar.reset();
+}
+
+void StartupWindow::SetBusy(bool busy) {
+    m_bBusy = busy;
+    ui->NextButton->setEnabled(!busy);
+    ui->BackButton->setEnabled(!busy);
+}
+
+void StartupWindow::StartReplayFarm(QFileInfo capture, QString args) {
+    m_ReplayFarm = std::make_unique<ReplayFarm>();
+    for (const std::string& serial : m_vecSelectedSerials)
+        m_ReplayFarm->Enqueue(serial, { capture, args, ui->CompressTransferBox->isChecked() });
+
+    connect(m_ReplayFarm.get(), &ReplayFarm::DeviceUpdated, this, &StartupWindow::OnReplayFarmUpdated);
+    connect(m_ReplayFarm.get(), &ReplayFarm::Finished, this, &StartupWindow::OnReplayFarmUpdated);
+
+    FlipPage(Page::FarmStatus);
+    m_ReplayFarm->Start();
+}
+
+void StartupWindow::OnReplayFarmUpdated() {
+    if (!m_ReplayFarm || m_eCurrentPage != Page::FarmStatus)
+        return;
+
+    ui->StatusLabel->setText(m_ReplayFarm->Summary());
+    if (m_ReplayFarm->IsFinished())
+        ui->NextButton->setText("Done");
+}
+
+void StartupWindow::WatchReplay(std::shared_ptr<ReplayWatcher> watcher) {
+    m_ReplayWatcher = watcher;
+    FlipPage(Page::Replaying);
+    m_ReplayTimer.start();
+
+    m_ReplayFuture = m_AdbAsync.Run([watcher](ADB&) {
+        return watcher->Watch();
+    });
+    m_ReplayFuture.then(this, [this](ReplayMonitor::Status status) {
+        m_ReplayTimer.stop();
+        if (m_eCurrentPage != Page::Replaying)
+            return;
+
+        ShowReplayStatus(status);
+        ui->NextButton->setText("Done");
+    });
+}
+
+void StartupWindow::OnReplayTimeout() {
+    if (m_ReplayWatcher)
+        ShowReplayStatus(m_ReplayWatcher->GetStatus());
+}
+
+void StartupWindow::ShowReplayStatus(const ReplayMonitor::Status& status) {
+    if (m_eCurrentPage != Page::Replaying)
+        return;
+    ui->StatusLabel->setText(status.Summary());
+}
+
 void StartupWindow::OnOpenButtonClicked() {
     LOGD("Open button clicked");
     QString filepath = PopFileOpenWindow();
+    if (!filepath.isEmpty())
+        OpenCapture(filepath);
+}
+
+void StartupWindow::OpenCapture(QString path) {
+    if (m_bBusy)
+        return;
+
+    // Indexing touches every block header, keep it off the GUI thread
+    SetBusy(true);
+    ui->OpenButton->setEnabled(false);
+    QtConcurrent::run([path]() {
+        auto capture = std::make_shared<CaptureFile>();
+        capture->Open(path);
+        return capture;
+    }).then(this, [this](std::shared_ptr<CaptureFile> capture) {
+        SetBusy(false);
+        ui->OpenButton->setEnabled(true);
+        if (!capture->IsOpen()) {
+            LOGW("%s", capture->GetError().toStdString().c_str());
+            return;
+        }
+
+        m_Capture = capture;
+        FlipPage(Page::Capture);
+        ShowCaptureSummary();
+    });
+}
+
+void StartupWindow::ShowCaptureSummary() {
+    if (!m_Capture || m_eCurrentPage != Page::Capture)
+        return;
+
+    static const char* COMPRESSION[] = { "none", "LZ4", "zlib", "zstd" };
+    const CaptureFile::Header& header = m_Capture->GetHeader();
+
+    ui->StatusLabel->setText(QString(
+        "Capture %1\n"
+        "Version: %2.%3\n"
+        "Compression: %4%10\n"
+        "Size: %5 MB\n"
+        "Blocks: %6 (%7 compressed)\n"
+        "API calls: %8\n"
+        "Frames: %11\n"
+        "Index: %12%9")
+        .arg(m_Capture->GetPath())
+        .arg(header.majorVersion)
+        .arg(header.minorVersion)
+        .arg(COMPRESSION[static_cast<uint32_t>(header.compression)])
+        .arg(m_Capture->GetSize() / 1e6, 0, 'f', 1)
+        .arg(m_Capture->GetBlocks().size())
+        .arg(m_Capture->GetCompressedBlockCount())
+        .arg(m_Capture->GetCallCount())
+        .arg(m_Capture->IsTruncated() ? "\nLast block is cut short" : "")
+        .arg(BlockDecompressor::IsSupported(header.compression) ? "" : " (not supported by this build)")
+        .arg(m_Capture->GetFrames().size())
+        .arg(m_Capture->IsIndexLoaded() ? "loaded from sidecar" : "built"));
+}
+
+void StartupWindow::OnFrameSliderMoved(int frame) {
+    if (m_eCurrentPage == Page::Frame && frame >= 1)
+        SeekFrame(frame - 1);
+}
+
+void StartupWindow::OnCallTreeCollapsed(const QModelIndex& index) {
+    m_CallTreeModel->ReleaseFrame(index);
+}
+
+// Only the first chunk of a frame is read here, however large it is, so
+// scrubbing stays interactive; the rest is read as the view scrolls
+void StartupWindow::SeekFrame(uint64_t frame) {
+    const QModelIndex index = m_CallTreeModel->FrameIndex(frame);
+    if (!index.isValid())
+        return;
+
+    if (m_SeekedFrame.isValid() && m_SeekedFrame != index)
+        ui->CallTreeView->collapse(m_SeekedFrame);
+    m_SeekedFrame = index;
+    if (m_CallTreeModel->canFetchMore(index))
+        m_CallTreeModel->fetchMore(index);
+    ui->CallTreeView->expand(index);
+    ui->CallTreeView->setCurrentIndex(index);
+    ui->CallTreeView->scrollTo(index, QAbstractItemView::PositionAtTop);
+}
+
+// The call table is built for the first filter, which reads the whole
+// capture; later filters only scan it
+void StartupWindow::FilterCalls(const QString& text) {
+    std::vector<vkdecode::CallTable::Query> queries;
+    std::string error;
+    if (!vkdecode::CallTable::Parse(text.toStdString(), queries, error)) {
+        LOGW("%s", error.c_str());
+        ui->InputLineEdit->selectAll();
+        return;
+    }
+    if (m_CallTable) {
+        ApplyFilter(queries);
+        return;
+    }
+    if (m_bBusy)
+        return;
+
+    SetBusy(true);
+    m_CallTableStop = std::stop_source();
+    m_CallTableFuture = QtConcurrent::run([capture = m_Capture, stop = m_CallTableStop.get_token()]() {
+        return CallTreeModel::BuildCallTable(*capture, stop);
+    });
+    m_CallTableFuture.then(this, [this, capture = m_Capture, queries](std::shared_ptr<const vkdecode::CallTable> table) {
+        SetBusy(false);
+        if (!table || capture != m_Capture || !m_CallTreeModel)
+            return;
+        m_CallTable = table;
+        ApplyFilter(queries);
+    });
+}
+
+void StartupWindow::ApplyFilter(const std::vector<vkdecode::CallTable::Query>& queries) {
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<uint32_t> rows = m_CallTable->Filter(queries);
+    LOGD("Filter matched %zu of %zu calls in %lld ms", rows.size(), m_CallTable->GetRowCount(), timer.elapsed());
+
+    m_SeekedFrame = QModelIndex();
+    m_CallTreeModel->SetFilter(m_CallTable, std::move(rows));
+    SeekFrame(ui->FrameSlider->value() - 1);
 }
 
 QString StartupWindow::PopFileOpenWindow() {
@@ -27,10 +27,24 @@
 #include <QWidget>
 #include <QStringListModel>
 #include <QMouseEvent>
+#include <QTimer>
+#include <QFuture>
+#include <QFutureWatcher>
+
+#include <memory>
+#include <stop_token>
 
 #include "ui_StartupWindow.h"
 #include "StartupWindowBackground.hpp"
 #include "adb.hpp"
+#include "adbasync.hpp"
+#include "ProgressBar.hpp"
+#include "devicetracker.hpp"
+#include "capturefollower.hpp"
+#include "replayfarm.hpp"
+#include "replaywatcher.hpp"
+#include "capturefile.hpp"
+#include "calltreemodel.hpp"
 
 class StartupWindow : public QWidget {
     Q_OBJECT
@@ -47,6 +61,11 @@ private:
         Option,
         Replay,
         FileSelect,
+        Recording,
+        FarmStatus,
+        Replaying,
+        Capture,
+        Frame,
     };
 
     void mousePressEvent(QMouseEvent* event) override;
@@ -58,6 +77,29 @@ private:
     void OnBackButtonClicked();
     void OnFileSelectButtonClicked();
     void OnOpenButtonClicked();
+    void OnFollowTimeout();
+    void ShowFollowProgress(const CaptureFollower::Progress& progress);
+    QFuture<void> StopFollowing();
+    void SetListModel(QAbstractItemModel* model);
+    void LoadList(QFuture<std::string> future);
+    void LoadDevices();
+    void OnTrackingChanged(bool tracking);
+    void OnListResultsReady(int begin, int end);
+    void OnTransferProgress(QString text, int percent);
+    void CloseProgress();
+    void SetBusy(bool busy);
+    void StartReplayFarm(QFileInfo capture, QString args);
+    void OnReplayFarmUpdated();
+    void WatchReplay(std::shared_ptr<ReplayWatcher> watcher);
+    void OnReplayTimeout();
+    void ShowReplayStatus(const ReplayMonitor::Status& status);
+    void OpenCapture(QString path);
+    void ShowCaptureSummary();
+    void OnFrameSliderMoved(int frame);
+    void OnCallTreeCollapsed(const QModelIndex& index);
+    void SeekFrame(uint64_t frame);
+    void FilterCalls(const QString& text);
+    void ApplyFilter(const std::vector<vkdecode::CallTable::Query>& queries);
     QString PopFileOpenWindow();
 
 private:
@@ -65,7 +107,26 @@ private:
     QPoint m_DragPos;
     Page m_eCurrentPage;
     ADB adb;
+    AdbAsync m_AdbAsync;
+    bool m_bBusy;
+    QFutureWatcher<std::string> m_ListWatcher;
+    std::unique_ptr<ProgressBar> m_ProgressBar;
     QStringListModel m_ListModel;
+    DeviceTracker m_DeviceTracker;
     std::string m_strSelectedPackage;
     std::string m_strSelectedActivity;
+    std::shared_ptr<CaptureFollower> m_CaptureFollower;
+    QFuture<CaptureFollower::Progress> m_FollowFuture;
+    QTimer m_FollowTimer;
+    std::vector<std::string> m_vecSelectedSerials;
+    std::unique_ptr<ReplayFarm> m_ReplayFarm;
+    std::shared_ptr<ReplayWatcher> m_ReplayWatcher;
+    QFuture<ReplayMonitor::Status> m_ReplayFuture;
+    QTimer m_ReplayTimer;
+    std::shared_ptr<CaptureFile> m_Capture;
+    std::unique_ptr<CallTreeModel> m_CallTreeModel;
+    QModelIndex m_SeekedFrame;
+    std::shared_ptr<const vkdecode::CallTable> m_CallTable;
+    QFuture<std::shared_ptr<const vkdecode::CallTable>> m_CallTableFuture;
+    std::stop_source m_CallTableStop;
 };
\ No newline at end of file
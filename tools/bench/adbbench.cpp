@@ -0,0 +1,247 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+// Benchmarks the ADB class against fakeadb: shell round trips, push
+// throughput, package listing against growing package counts and the time
+// from a capture on disk to a launched replay. With --baseline it compares
+// every metric against the recorded value and fails on regressions beyond
+// the tolerance; --write-baseline records the current run instead. Without
+// either it only fails when an operation fails.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTemporaryDir>
+#include <QTcpServer>
+#include <QProcess>
+#include <QFile>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QThread>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "adb.hpp"
+#include "adbclient.hpp"
+#include "packagecache.hpp"
+
+struct Metric {
+	double value;
+	QString unit;
+	bool higherIsBetter;
+};
+
+static const std::vector<int> PACKAGE_COUNTS = { 10, 100, 500 };
+
+static quint16 freePort() {
+	QTcpServer probe;
+	probe.listen(QHostAddress::LocalHost, 0);
+	return probe.serverPort();
+}
+
+static double median(std::vector<double> values) {
+	std::sort(values.begin(), values.end());
+	return values.empty() ? 0.0 : values[values.size() / 2];
+}
+
+static bool writeRandomFile(const QString& path, qint64 size) {
+	QFile f(path);
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+	QByteArray block(1 << 20, Qt::Uninitialized);
+	for (qint64 written = 0; written < size; written += block.size()) {
+		QRandomGenerator::global()->fillRange(reinterpret_cast<quint32*>(block.data()), block.size() / sizeof(quint32));
+		if (f.write(block.constData(), std::min<qint64>(block.size(), size - written)) < 0)
+			return false;
+	}
+	return true;
+}
+
+static std::map<QString, Metric> runBenchmarks(const QString& workDir, int pushSizeMb, int shellRounds, int& errors) {
+	std::map<QString, Metric> metrics;
+	ADB adb;
+	adb.SetProgressHandler([](QString, int) { return true; });
+
+	// Shell round trip over the persistent session
+	if (!adb.ConnectDevice("bench-10")) {
+		std::cerr << "adbbench: cannot connect to bench-10" << std::endl;
+		errors++;
+		return metrics;
+	}
+	std::vector<double> rounds;
+	for (int i = 0; i < shellRounds; i++) {
+		QElapsedTimer timer;
+		timer.start();
+		adb.ShellCommand(QString("echo %1").arg(i));
+		rounds.push_back(timer.nsecsElapsed() / 1e6);
+	}
+	metrics["shell_rtt_p50_ms"] = { median(rounds), "ms", false };
+
+	// Raw push throughput
+	const QString pushFile = QDir(workDir).filePath("push.bin");
+	writeRandomFile(pushFile, static_cast<qint64>(pushSizeMb) << 20);
+	QElapsedTimer timer;
+	timer.start();
+	if (adb.PushFile(QFileInfo(pushFile), "/sdcard/Download/")) {
+		metrics["push_mb_per_s"] = { pushSizeMb * 1.048576 / std::max(timer.elapsed() / 1000.0, 0.001), "MB/s", true };
+	}
+	else {
+		std::cerr << "adbbench: push failed" << std::endl;
+		errors++;
+	}
+
+	// Package listing, cold cache, per package count
+	for (int count : PACKAGE_COUNTS) {
+		const std::string serial = QString("bench-%1").arg(count).toStdString();
+		if (!adb.ConnectDevice(serial)) {
+			std::cerr << "adbbench: cannot connect to " << serial << std::endl;
+			errors++;
+			continue;
+		}
+		PackageCache::getInstance().Invalidate(serial);
+		timer.restart();
+		const size_t packages = adb.GetPackages().size();
+		metrics[QString("packages_%1_ms").arg(count)] = { static_cast<double>(timer.elapsed()), "ms", false };
+		if (packages != static_cast<size_t>(count)) {
+			std::cerr << "adbbench: " << serial << " listed " << packages << " packages" << std::endl;
+			errors++;
+		}
+	}
+
+	// Capture on disk to launched replay, first upload and unchanged re-upload
+	adb.ConnectDevice("bench-10");
+	const QString capture = QDir(workDir).filePath("bench.gfxr");
+	writeRandomFile(capture, 16 << 20);
+	for (const char* name : { "replay_launch_cold_ms", "replay_launch_warm_ms" }) {
+		timer.restart();
+		const QString remote = ADB::GetReplayFile("bench.gfxr");
+		if (adb.SyncFile(QFileInfo(capture), remote) && adb.LaunchReplay(remote, "")) {
+			metrics[name] = { static_cast<double>(timer.elapsed()), "ms", false };
+		}
+		else {
+			std::cerr << "adbbench: " << name << ": upload or launch failed" << std::endl;
+			errors++;
+		}
+	}
+
+	adb.Disconnect();
+	return metrics;
+}
+
+int main(int argc, char* argv[]) {
+	QCoreApplication app(argc, argv);
+
+	QCommandLineParser parser;
+	parser.addHelpOption();
+	parser.addOptions({
+		{ "fakeadb", "Path to the fakeadb executable", "path", "fakeadb" },
+		{ "baseline", "Fail when a metric regresses against this file", "file" },
+		{ "write-baseline", "Record this run as the baseline", "file" },
+		{ "tolerance", "Allowed regression as a fraction of the baseline", "fraction", "0.25" },
+		{ "latency", "Latency fakeadb adds to every request", "ms", "1" },
+		{ "bandwidth", "Transfer limit fakeadb applies, 0 for none", "mbps", "0" },
+		{ "push-size", "Size of the pushed file", "mb", "64" },
+		{ "rounds", "Shell round trips to time", "n", "200" },
+	});
+	parser.process(app);
+
+	QTemporaryDir workDir;
+	if (!workDir.isValid())
+		return 1;
+
+	const quint16 port = freePort();
+	QStringList serverArgs = { "server", "--port", QString::number(port), "--root", workDir.filePath("devices"),
+		"--latency", parser.value("latency"), "--bandwidth", parser.value("bandwidth") };
+	for (int count : PACKAGE_COUNTS)
+		serverArgs << "--device" << QString("bench-%1:%1").arg(count);
+
+	QProcess server;
+	server.setProcessChannelMode(QProcess::ForwardedChannels);
+	server.start(parser.value("fakeadb"), serverArgs);
+	if (!server.waitForStarted()) {
+		std::cerr << "adbbench: cannot start " << parser.value("fakeadb").toStdString() << std::endl;
+		return 1;
+	}
+
+	qputenv("ADB_SERVER_SOCKET", QString("tcp:127.0.0.1:%1").arg(port).toUtf8());
+	AdbClient client;
+	for (int attempt = 0; attempt < 50 && !client.IsAvailable(); attempt++)
+		QThread::msleep(100);
+
+	int errors = 0;
+	std::map<QString, Metric> metrics = runBenchmarks(workDir.path(), parser.value("push-size").toInt(), parser.value("rounds").toInt(), errors);
+
+	server.kill();
+	server.waitForFinished();
+
+	QJsonObject current;
+	for (const auto& [name, metric] : metrics) {
+		current.insert(name, QJsonObject{ { "value", metric.value }, { "unit", metric.unit }, { "higher_is_better", metric.higherIsBetter } });
+		std::cout << QString("%1 %2 %3").arg(name, -28).arg(metric.value, 10, 'f', 2).arg(metric.unit).toStdString() << std::endl;
+	}
+
+	if (parser.isSet("write-baseline")) {
+		QFile f(parser.value("write-baseline"));
+		if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+			return 1;
+		f.write(QJsonDocument(current).toJson());
+	}
+
+	if (errors)
+		return 1;
+	if (!parser.isSet("baseline"))
+		return 0;
+
+	QFile f(parser.value("baseline"));
+	if (!f.open(QIODevice::ReadOnly)) {
+		std::cerr << "adbbench: cannot read baseline" << std::endl;
+		return 1;
+	}
+	const QJsonObject baseline = QJsonDocument::fromJson(f.readAll()).object();
+	const double tolerance = parser.value("tolerance").toDouble();
+
+	int regressions = 0;
+	for (auto it = baseline.begin(); it != baseline.end(); ++it) {
+		const double expected = it.value().toObject().value("value").toDouble();
+		const bool higherIsBetter = it.value().toObject().value("higher_is_better").toBool();
+		auto found = metrics.find(it.key());
+		if (found == metrics.end()) {
+			std::cerr << "REGRESSION " << it.key().toStdString() << ": not measured" << std::endl;
+			regressions++;
+			continue;
+		}
+		const double value = found->second.value;
+		const bool regressed = higherIsBetter ? value < expected * (1 - tolerance) : value > expected * (1 + tolerance);
+		if (regressed) {
+			std::cerr << "REGRESSION " << it.key().toStdString() << ": " << value << " against baseline " << expected << std::endl;
+			regressions++;
+		}
+	}
+	return regressions ? 1 : 0;
+}
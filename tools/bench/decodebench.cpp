@@ -0,0 +1,195 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+// Allocations and time per decoded call, for call records on the heap as
+// one object, name and value vector each, against records in a per batch
+// arena with interned names. Calls are decoded in batches the size of a
+// call tree fetch and a batch is dropped at once, as a collapsed frame is.
+// With --max-allocs-per-call it fails when the arena path allocates more.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "vulkancalls.hpp"
+
+static std::atomic<uint64_t> allocations = 0;
+
+void* operator new(size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	free(p);
+}
+
+struct Input {
+	uint32_t id;
+	uint64_t thread;
+	std::vector<uint8_t> params;
+};
+
+struct Result {
+	double allocsPerCall;
+	double nsPerCall;
+};
+
+// What a record looks like without the arena
+struct HeapCall {
+	uint32_t id;
+	std::string name;
+	std::vector<vkdecode::Value> values;
+	uint64_t thread;
+	uint64_t paramSize;
+};
+
+static constexpr size_t BATCH = 4096;
+static constexpr size_t PARAM_SIZE = 64;
+
+// Known calls from the table where there is one, with a share of IDs it
+// does not know
+static std::vector<Input> makeInputs(size_t count) {
+	std::vector<uint32_t> known;
+	for (uint32_t id = 0x11000; id < 0x12000; id++) {
+		if (vkdecode::FindCall(id))
+			known.push_back(id);
+	}
+
+	std::vector<Input> inputs(count);
+	uint64_t seed = 0x9e3779b97f4a7c15ull;
+	for (size_t i = 0; i < count; i++) {
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		Input& input = inputs[i];
+		input.id = known.empty() || i % 8 == 7 ? 0x20000 + static_cast<uint32_t>(seed >> 58) : known[(seed >> 33) % known.size()];
+		input.thread = 1 + i % 4;
+		input.params.resize(PARAM_SIZE);
+		for (size_t j = 0; j < PARAM_SIZE; j++)
+			input.params[j] = static_cast<uint8_t>(seed >> (j % 8 * 8));
+	}
+	return inputs;
+}
+
+template<typename Batch>
+static Result measure(const std::vector<Input>& inputs, Batch batch) {
+	const uint64_t before = allocations.load();
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t begin = 0; begin < inputs.size(); begin += BATCH)
+		batch(inputs.data() + begin, std::min(BATCH, inputs.size() - begin));
+	const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	const double calls = static_cast<double>(inputs.size());
+	return { (allocations.load() - before) / calls, elapsed.count() / calls };
+}
+
+static Result runHeap(const std::vector<Input>& inputs) {
+	std::vector<std::unique_ptr<HeapCall>> records;
+	records.reserve(BATCH);
+	return measure(inputs, [&](const Input* batch, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			const Input& input = batch[i];
+			auto call = std::make_unique<HeapCall>();
+			call->id = input.id;
+			call->thread = input.thread;
+			call->paramSize = input.params.size();
+			const vkdecode::CallInfo* info = vkdecode::FindCall(input.id);
+			if (info) {
+				vkdecode::Value values[vkdecode::MAX_VALUES];
+				call->name = info->name;
+				call->values.assign(values, values + info->decode(input.params.data(), input.params.size(), values));
+			}
+			else {
+				char name[16];
+				snprintf(name, sizeof(name), "0x%08x", input.id);
+				call->name = name;
+			}
+			records.push_back(std::move(call));
+		}
+		records.clear();
+	});
+}
+
+static Result runArena(const std::vector<Input>& inputs, size_t& bytesPerBatch) {
+	Arena arena;
+	StringTable names;
+	std::vector<const vkdecode::DecodedCall*> records;
+	records.reserve(BATCH);
+	bytesPerBatch = 0;
+	return measure(inputs, [&](const Input* batch, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			const Input& input = batch[i];
+			vkdecode::DecodedCall* call = vkdecode::DecodeCall(input.id, input.params.data(), input.params.size(), arena, names);
+			call->thread = input.thread;
+			records.push_back(call);
+		}
+		bytesPerBatch = std::max(bytesPerBatch, arena.GetBytesUsed());
+		records.clear();
+		arena.Reset();
+	});
+}
+
+int main(int argc, char* argv[]) {
+	size_t calls = 1 << 20;
+	double maxAllocs = -1;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--calls") && i + 1 < argc)
+			calls = strtoull(argv[++i], nullptr, 10);
+		else if (!strcmp(argv[i], "--max-allocs-per-call") && i + 1 < argc)
+			maxAllocs = strtod(argv[++i], nullptr);
+		else {
+			std::cerr << "usage: decodebench [--calls n] [--max-allocs-per-call n]" << std::endl;
+			return 1;
+		}
+	}
+
+	const std::vector<Input> inputs = makeInputs(calls);
+	if (!vkdecode::CallCount())
+		std::cout << "decodebench: built without the Vulkan registry, every call is unknown" << std::endl;
+
+	size_t bytesPerBatch;
+	const Result heap = runHeap(inputs);
+	const Result arena = runArena(inputs, bytesPerBatch);
+	printf("%-12s %10.4f allocs/call %10.1f ns/call\n", "heap", heap.allocsPerCall, heap.nsPerCall);
+	printf("%-12s %10.4f allocs/call %10.1f ns/call %8.1f bytes/call\n", "arena", arena.allocsPerCall, arena.nsPerCall,
+		static_cast<double>(bytesPerBatch) / std::min(BATCH, std::max<size_t>(calls, 1)));
+
+	if (maxAllocs >= 0 && arena.allocsPerCall > maxAllocs) {
+		std::cerr << "REGRESSION allocs/call: " << arena.allocsPerCall << " above " << maxAllocs << std::endl;
+		return 1;
+	}
+	return 0;
+}
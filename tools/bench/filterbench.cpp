@@ -0,0 +1,130 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+// Filter scans over a synthetic call table, per instruction set: a draw
+// query over a frame range with a parameter condition, one on a thread
+// and one with too many call IDs for the vector kernels. Every instruction
+// set must return the same rows. With --max-ms it fails when the best one
+// takes longer on any query.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "calltable.hpp"
+
+using vkdecode::CallTable;
+
+struct Case {
+	const char* name;
+	CallTable::Query query;
+};
+
+static constexpr uint32_t FRAMES = 1000;
+static constexpr uint32_t FIRST_ID = 0x11000;
+static constexpr uint32_t ID_COUNT = 200;
+
+static void fill(CallTable& table, size_t calls) {
+	table.Reserve(calls);
+	uint64_t seed = 0x9e3779b97f4a7c15ull;
+	vkdecode::Value values[CallTable::HOT_PARAMS + 1] = {};
+	for (size_t i = 0; i < calls; i++) {
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		for (size_t j = 1; j <= CallTable::HOT_PARAMS; j++)
+			values[j].bits = (seed >> (j * 8)) % 4;
+		const uint32_t id = FIRST_ID + static_cast<uint32_t>((seed >> 40) % ID_COUNT);
+		const uint32_t frame = static_cast<uint32_t>(i * FRAMES / calls);
+		table.Append(id, frame, 1 + (seed >> 60) % 4, static_cast<uint32_t>(i), values, CallTable::HOT_PARAMS + 1);
+	}
+}
+
+static std::vector<Case> makeCases() {
+	std::vector<Case> cases(3);
+	cases[0].name = "draws_frames_param";
+	for (uint32_t i = 0; i < 8; i++)
+		cases[0].query.ids.push_back(FIRST_ID + 100 + i);
+	cases[0].query.firstFrame = 99;
+	cases[0].query.endFrame = 900;
+	cases[0].query.conditions.push_back({ 1, CallTable::Op::Gt, 1 });
+
+	cases[1].name = "thread_two_params";
+	cases[1].query.anyThread = false;
+	cases[1].query.thread = 2;
+	cases[1].query.conditions.push_back({ 0, CallTable::Op::Eq, 3 });
+	cases[1].query.conditions.push_back({ 3, CallTable::Op::Le, 1 });
+
+	cases[2].name = "many_ids";
+	for (uint32_t i = 0; i < 40; i++)
+		cases[2].query.ids.push_back(FIRST_ID + i * 3);
+	return cases;
+}
+
+int main(int argc, char* argv[]) {
+	size_t calls = 50000000;
+	double maxMs = -1;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--calls") && i + 1 < argc)
+			calls = strtoull(argv[++i], nullptr, 10);
+		else if (!strcmp(argv[i], "--max-ms") && i + 1 < argc)
+			maxMs = strtod(argv[++i], nullptr);
+		else {
+			std::cerr << "usage: filterbench [--calls n] [--max-ms n]" << std::endl;
+			return 1;
+		}
+	}
+
+	CallTable table;
+	fill(table, calls);
+	printf("%zu calls, %.1f MB of columns\n", table.GetRowCount(), table.GetBytes() / 1e6);
+
+	static const char* ISA_NAMES[] = { "scalar", "sse2", "avx2" };
+	const CallTable::Isa best = CallTable::GetBestIsa();
+	int failures = 0;
+	for (const Case& test : makeCases()) {
+		std::vector<uint32_t> expected;
+		for (int isa = 0; isa <= static_cast<int>(best); isa++) {
+			const auto start = std::chrono::steady_clock::now();
+			const std::vector<uint32_t> rows = table.Filter(test.query, static_cast<CallTable::Isa>(isa));
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			printf("%-20s %-7s %10zu rows %8.1f ms\n", test.name, ISA_NAMES[isa], rows.size(), elapsed.count());
+
+			if (isa == 0) {
+				expected = rows;
+			}
+			else if (rows != expected) {
+				std::cerr << "MISMATCH " << test.name << ": " << ISA_NAMES[isa] << " differs from scalar" << std::endl;
+				failures++;
+			}
+			if (isa == static_cast<int>(best) && maxMs >= 0 && elapsed.count() > maxMs) {
+				std::cerr << "REGRESSION " << test.name << ": " << elapsed.count() << " ms above " << maxMs << std::endl;
+				failures++;
+			}
+		}
+	}
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+// Replays a capture several times on each device and reports FPS and frame
+// time with 95% confidence intervals. With --baseline every device and
+// capture is compared against the recorded runs, and a significant FPS or
+// frame time regression makes the run fail; --write-baseline records this
+// run instead.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "adb.hpp"
+#include "replayfarm.hpp"
+#include "replaystats.hpp"
+
+struct Result {
+	ReplayStats::Summary fps;
+	ReplayStats::Summary frameMs;
+};
+
+static Result summarize(const std::vector<ReplayStats::Sample>& samples) {
+	std::vector<double> fps;
+	std::vector<double> frameMs;
+	for (const ReplayStats::Sample& sample : samples) {
+		fps.push_back(sample.fps);
+		frameMs.push_back(sample.frameMs);
+	}
+	return { ReplayStats::Summarize(fps), ReplayStats::Summarize(frameMs) };
+}
+
+static void print(const QString& name, const ReplayStats::Summary& summary, const QString& unit) {
+	std::cout << QString("  %1 %2 %3  95% CI %4 - %5  stddev %6  (%7 runs)")
+		.arg(name, -10).arg(summary.mean, 10, 'f', 3).arg(unit, -4)
+		.arg(summary.ciLow, 0, 'f', 3).arg(summary.ciHigh, 0, 'f', 3)
+		.arg(std::sqrt(summary.variance), 0, 'f', 3).arg(summary.runs).toStdString() << std::endl;
+}
+
+// Higher FPS and lower frame times are better
+static bool regressed(const QString& where, const QString& name, const ReplayStats::Summary& baseline,
+	const ReplayStats::Summary& current, bool higherIsBetter, double minChange) {
+	const ReplayStats::Comparison comparison = ReplayStats::Compare(baseline, current, minChange);
+	const bool worse = higherIsBetter ? comparison.change < 0 : comparison.change > 0;
+	const QString verdict = !comparison.significant ? "no significant change" : worse ? "REGRESSION" : "improvement";
+	std::cout << QString("  %1 %2: %3 -> %4 (%5%6%, t=%7, critical %8) %9")
+		.arg(where, name).arg(baseline.mean, 0, 'f', 3).arg(current.mean, 0, 'f', 3)
+		.arg(comparison.change >= 0 ? "+" : "").arg(comparison.change * 100, 0, 'f', 1)
+		.arg(comparison.t, 0, 'f', 2).arg(comparison.critical, 0, 'f', 2).arg(verdict).toStdString() << std::endl;
+	return comparison.significant && worse;
+}
+
+int main(int argc, char* argv[]) {
+	QCoreApplication app(argc, argv);
+	ADB::SetupEnvironment();
+
+	QCommandLineParser parser;
+	parser.addHelpOption();
+	parser.addPositionalArgument("capture", "Capture file to replay");
+	parser.addOptions({
+		{ "device", "Device to replay on, all connected devices when not given", "serial" },
+		{ "runs", "Replays per device", "n", "5" },
+		{ "range", "Frames to measure, passed to --measurement-frame-range", "start-end" },
+		{ "args", "Extra gfxrecon-replay arguments", "args" },
+		{ "compress", "Compress the capture transfer" },
+		{ "baseline", "Fail on a significant regression against this file", "file" },
+		{ "write-baseline", "Record this run as the baseline", "file" },
+		{ "min-change", "Smallest relative change that counts as a regression", "fraction", "0.02" },
+	});
+	parser.process(app);
+
+	if (parser.positionalArguments().size() != 1)
+		parser.showHelp(1);
+	const QFileInfo capture(parser.positionalArguments().front());
+	if (!capture.isFile()) {
+		std::cerr << "replaybench: cannot find " << capture.filePath().toStdString() << std::endl;
+		return 1;
+	}
+
+	std::vector<std::string> serials;
+	for (const QString& serial : parser.values("device"))
+		serials.push_back(serial.toStdString());
+	if (serials.empty())
+		serials = ADB().GetDevices();
+	if (serials.empty()) {
+		std::cerr << "replaybench: no device" << std::endl;
+		return 1;
+	}
+
+	QString args = parser.value("args");
+	if (!args.isEmpty() && !args.endsWith(' '))
+		args += ' ';
+
+	ReplayFarm farm;
+	for (const std::string& serial : serials)
+		farm.Enqueue(serial, { capture, args, parser.isSet("compress"), parser.value("runs").toInt(), parser.value("range") });
+
+	QObject::connect(&farm, &ReplayFarm::DeviceUpdated, [&farm](QString serial) {
+		const ReplayFarm::DeviceStatus device = farm.GetStatus()[serial.toStdString()];
+		if (!device.finished)
+			std::cout << QString("%1: %2").arg(serial, device.stage).toStdString() << std::endl;
+	});
+	QObject::connect(&farm, &ReplayFarm::Finished, &app, &QCoreApplication::quit);
+	farm.Start();
+	app.exec();
+
+	const QString name = capture.fileName();
+	bool ok = true;
+	QJsonObject current;
+	std::map<std::string, Result> results;
+	for (const auto& [serial, device] : farm.GetStatus()) {
+		std::cout << serial << ": ";
+		if (!device.ok) {
+			std::cout << "failed, " << device.error.toStdString() << std::endl;
+			ok = false;
+			continue;
+		}
+		std::cout << name.toStdString() << std::endl;
+
+		auto samples = device.samples.find(name);
+		if (samples == device.samples.end())
+			continue;
+		const Result result = summarize(samples->second);
+		print("fps", result.fps, "");
+		print("frame time", result.frameMs, "ms");
+		results[serial] = result;
+
+		QJsonObject captures = current.value(QString::fromStdString(serial)).toObject();
+		captures.insert(name, QJsonObject{ { "fps", result.fps.ToJson() }, { "frame_ms", result.frameMs.ToJson() } });
+		current.insert(QString::fromStdString(serial), captures);
+	}
+
+	if (parser.isSet("write-baseline")) {
+		QFile f(parser.value("write-baseline"));
+		if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+			return 1;
+		f.write(QJsonDocument(current).toJson());
+	}
+
+	if (!parser.isSet("baseline"))
+		return ok ? 0 : 1;
+
+	QFile f(parser.value("baseline"));
+	if (!f.open(QIODevice::ReadOnly)) {
+		std::cerr << "replaybench: cannot read baseline" << std::endl;
+		return 1;
+	}
+	const QJsonObject baseline = QJsonDocument::fromJson(f.readAll()).object();
+	const double minChange = parser.value("min-change").toDouble();
+
+	int regressions = 0;
+	std::cout << "Against " << parser.value("baseline").toStdString() << ":" << std::endl;
+	for (const auto& [serial, result] : results) {
+		const QJsonObject recorded = baseline.value(QString::fromStdString(serial)).toObject().value(name).toObject();
+		if (recorded.isEmpty()) {
+			std::cout << "  " << serial << ": no baseline for " << name.toStdString() << std::endl;
+			continue;
+		}
+		const QString where = QString::fromStdString(serial);
+		regressions += regressed(where, "fps", ReplayStats::Summary::FromJson(recorded.value("fps").toObject()), result.fps, true, minChange);
+		regressions += regressed(where, "frame time", ReplayStats::Summary::FromJson(recorded.value("frame_ms").toObject()), result.frameMs, false, minChange);
+	}
+
+	return ok && regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+# MIT License
+#
+# Copyright (c) 2025-2026 kuloPo
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""Generates the Vulkan call table of src/decode/vulkancalls.cpp from vk.xml.
+
+Names and parameter layouts come from the registry. GFXReconstruct numbers
+calls in its own framework/format/api_call_id.h, which vk.xml knows nothing
+about; pass it with --ids to cover every call. Without it, the Vulkan 1.0
+commands, then VK_KHR_surface and VK_KHR_swapchain, are numbered from
+0x1000 in registry order, which is how GFXReconstruct numbered those.
+"""
+
+import argparse
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+VULKAN_FAMILY = 1
+FIRST_CALL = 0x1000
+DEFAULT_ORDER = ["VK_VERSION_1_0", "VK_KHR_surface", "VK_KHR_swapchain"]
+MAX_PARAMS = 31
+
+# Parameters passed by value, as GFXReconstruct writes them
+C_TYPES = {
+    "uint32_t": "U32",
+    "int32_t": "I32",
+    "uint64_t": "U64",
+    "int64_t": "I64",
+    "size_t": "U64",
+    "float": "F32",
+    "VkBool32": "Bool32",
+    "VkFlags": "Flags",
+    "VkFlags64": "Flags64",
+    "VkDeviceSize": "U64",
+    "VkDeviceAddress": "U64",
+    "VkSampleMask": "U32",
+    "VkResult": "Result",
+}
+
+
+def for_vulkan(element):
+    api = element.get("api")
+    return api is None or "vulkan" in api.split(",")
+
+
+def element_text(element):
+    return "".join(element.itertext())
+
+
+class Registry:
+    def __init__(self, path):
+        root = ET.parse(path).getroot()
+        self.kinds = dict(C_TYPES)
+        self.commands = {}
+        self.order = {}
+        self.results = []
+        self.read_types(root)
+        self.read_commands(root)
+        self.read_order(root)
+        self.read_results(root)
+
+    def read_types(self, root):
+        aliases = {}
+        for element in root.iter("type"):
+            category = element.get("category")
+            if category not in ("handle", "enum", "bitmask", "basetype") or not for_vulkan(element):
+                continue
+            name = element.get("name") or element.findtext("name")
+            if not name:
+                continue
+            if element.get("alias"):
+                aliases[name] = element.get("alias")
+            elif category == "handle":
+                self.kinds[name] = "Handle"
+            elif category == "enum":
+                self.kinds.setdefault(name, "Enum")
+            elif category == "bitmask":
+                self.kinds[name] = "Flags64" if element.findtext("type") == "VkFlags64" else "Flags"
+            elif category == "basetype" and element.findtext("type") in C_TYPES:
+                self.kinds.setdefault(name, C_TYPES[element.findtext("type")])
+        for name, alias in aliases.items():
+            if alias in self.kinds:
+                self.kinds[name] = self.kinds[alias]
+
+    def read_commands(self, root):
+        aliases = {}
+        for element in root.find("commands"):
+            if element.tag != "command" or not for_vulkan(element):
+                continue
+            if element.get("alias"):
+                aliases[element.get("name")] = element.get("alias")
+                continue
+            proto = element.find("proto")
+            name = proto.findtext("name")
+            params = []
+            for param in element.findall("param"):
+                if not for_vulkan(param):
+                    continue
+                text = element_text(param)
+                tail = text.split(param.findtext("name"), 1)[1]
+                pointer = "*" in text or "[" in tail
+                params.append((param.findtext("name"), None if pointer else self.kinds.get(param.findtext("type"))))
+            returns = proto.findtext("type")
+            self.commands[name] = (params, None if returns == "void" else self.kinds.get(returns, "Unknown"))
+        for name, alias in aliases.items():
+            if alias in self.commands:
+                self.commands[name] = self.commands[alias]
+
+    def read_order(self, root):
+        for element in list(root.iter("feature")) + list(root.iter("extension")):
+            commands = []
+            for require in element.findall("require"):
+                # Commands that depend on later versions or extensions got
+                # their numbers later too
+                if require.get("depends") or require.get("feature") or require.get("extension"):
+                    continue
+                if not for_vulkan(require):
+                    continue
+                for command in require.findall("command"):
+                    if command.get("name") not in commands:
+                        commands.append(command.get("name"))
+            self.order[element.get("name")] = commands
+
+    def read_results(self, root):
+        for enums in root.iter("enums"):
+            if enums.get("name") != "VkResult":
+                continue
+            for value in enums.findall("enum"):
+                if value.get("value") is not None:
+                    self.results.append((int(value.get("value"), 0), value.get("name")))
+        for section in list(root.iter("feature")) + list(root.iter("extension")):
+            number = section.get("number")
+            for value in section.iter("enum"):
+                if value.get("extends") != "VkResult" or value.get("alias"):
+                    continue
+                if value.get("value") is not None:
+                    self.results.append((int(value.get("value"), 0), value.get("name")))
+                elif value.get("offset") is not None:
+                    ext = int(value.get("extnumber") or number)
+                    code = 1000000000 + (ext - 1) * 1000 + int(value.get("offset"))
+                    self.results.append((-code if value.get("dir") == "-" else code, value.get("name")))
+        self.results = sorted(dict(self.results).items())
+
+
+def read_ids(path):
+    # ApiCall_vkX = MakeApiCallId(ApiFamilyId::ApiFamily_Vulkan, 0x1000)
+    pattern = re.compile(r"ApiCall(?:Id)?_(vk\w+)\s*=\s*MakeApiCallId\(\s*(?:ApiFamilyId::)?ApiFamily_Vulkan\s*,\s*(0x[0-9A-Fa-f]+)\s*\)")
+    with open(path, encoding="utf-8") as f:
+        return {name: (VULKAN_FAMILY << 16) | int(value, 16) for name, value in pattern.findall(f.read())}
+
+
+def default_ids(registry):
+    ids = {}
+    for section in DEFAULT_ORDER:
+        for name in registry.order.get(section, []):
+            ids.setdefault(name, (VULKAN_FAMILY << 16) | (FIRST_CALL + len(ids)))
+    return ids
+
+
+def layout(params, returns):
+    kinds = []
+    for _, kind in params:
+        if kind is None or kind == "Unknown":
+            break
+        kinds.append(kind)
+    complete = len(kinds) == len(params)
+    decoded = list(kinds)
+    if complete and returns not in (None, "Unknown"):
+        decoded.append(returns)
+    return kinds, complete, decoded
+
+
+def generate(registry, ids, source):
+    calls = sorted((ids[name], name) for name in ids if name in registry.commands)
+    out = []
+    out.append("// Generated by tools/codegen/gen_vulkan_calls.py from %s, do not edit" % source)
+    out.append("// Included by vulkancalls.cpp inside namespace vkdecode")
+    out.append("")
+    out.append("namespace generated {")
+    out.append("")
+    for _, name in calls:
+        params, returns = registry.commands[name]
+        kinds, _, _ = layout(params, returns)
+        if kinds:
+            entries = ", ".join('{ "%s", Kind::%s }' % (params[i][0], kinds[i]) for i in range(min(len(kinds), MAX_PARAMS)))
+            out.append("constexpr Param PARAMS_%s[] = { %s };" % (name, entries))
+    out.append("")
+    out.append("constexpr uint32_t FIRST_ID = 0x%08x;" % (calls[0][0] if calls else 0))
+    out.append("")
+    out.append("constexpr std::array<CallInfo, %d> CALLS = {{" % len(calls))
+    for id, name in calls:
+        params, returns = registry.commands[name]
+        kinds, complete, decoded = layout(params, returns)
+        kinds = kinds[:MAX_PARAMS]
+        decoded = decoded[:MAX_PARAMS + 1]
+        out.append('    { 0x%08x, "%s", %s, %d, %s, %s, &DecodeParams<%s> },' % (
+            id, name, "PARAMS_" + name if kinds else "nullptr", len(kinds),
+            "true" if complete and len(kinds) == len(params) else "false",
+            "true" if returns not in (None, "Unknown") else "false",
+            ", ".join("Kind::" + kind for kind in decoded)))
+    out.append("}};")
+    out.append("")
+    first = calls[0][0] if calls else 0
+    span = calls[-1][0] - first + 1 if calls else 0
+    index = ["0xffff"] * span
+    for position, (id, _) in enumerate(calls):
+        index[id - first] = str(position)
+    out.append("constexpr std::array<uint16_t, %d> INDEX = {{" % span)
+    for i in range(0, span, 16):
+        out.append("    " + ", ".join(index[i:i + 16]) + ",")
+    out.append("}};")
+    out.append("")
+    out.append("constexpr std::array<std::pair<int32_t, const char*>, %d> RESULTS = {{" % len(registry.results))
+    for value, name in registry.results:
+        out.append('    { %d, "%s" },' % (value, name))
+    out.append("}};")
+    out.append("")
+    out.append("}")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--xml", required=True, help="Vulkan registry vk.xml")
+    parser.add_argument("--ids", help="GFXReconstruct framework/format/api_call_id.h")
+    parser.add_argument("--output", required=True)
+    args = parser.parse_args()
+
+    registry = Registry(args.xml)
+    ids = read_ids(args.ids) if args.ids else default_ids(registry)
+    if args.ids and not ids:
+        print("gen_vulkan_calls: no Vulkan call IDs in %s" % args.ids, file=sys.stderr)
+        sys.exit(1)
+    missing = sorted(name for name in ids if name not in registry.commands)
+    if missing:
+        print("gen_vulkan_calls: %d call IDs not in %s, e.g. %s" % (len(missing), args.xml, missing[0]), file=sys.stderr)
+
+    text = generate(registry, ids, "vk.xml" if not args.ids else "vk.xml and api_call_id.h")
+    with open(args.output, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,179 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "fakedevice.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QRegularExpression>
+
+// Android tools the viewer calls, as host shell scripts
+static const char* STUBS[][2] = {
+	{ "pm", R"(#!/bin/sh
+list="$FAKE_ROOT/.fake/packages"
+case "$1" in
+list)
+	shift; full=0; for a in "$@"; do [ "$a" = "-f" ] && full=1; done
+	while read -r p; do
+		if [ $full = 1 ]; then echo "package:/data/app/~~fake==/$p-1==/base.apk=$p"; else echo "package:$p"; fi
+	done < "$list";;
+path)
+	grep -qx "$2" "$list" && echo "package:/data/app/~~fake==/$2-1==/base.apk";;
+install)
+	p=com.lunarg.gfxreconstruct.replay
+	grep -qx $p "$list" || echo $p >> "$list"
+	date +%s%N > "$FAKE_ROOT/.fake/$p.updated"
+	echo Success;;
+*)
+	exit 1;;
+esac
+)" },
+	{ "dumpsys", R"(#!/bin/sh
+list="$FAKE_ROOT/.fake/packages"
+if [ "$1" = package ] && [ "$2" = packages ]; then
+	while read -r p; do
+		printf '  Package [%s] (fake):\n    primaryCpuAbi=%s\n' "$p" "$FAKE_ABI"
+	done < "$list"
+elif [ "$1" = package ] && grep -qx "$2" "$list"; then
+	printf '    primaryCpuAbi=%s\n' "$FAKE_ABI"
+	printf '    lastUpdateTime=%s\n' "$(cat "$FAKE_ROOT/.fake/$2.updated" 2>/dev/null || echo 0)"
+fi
+)" },
+	{ "cmd", R"(#!/bin/sh
+list="$FAKE_ROOT/.fake/packages"
+if [ "$2" = query-activities ]; then
+	while read -r p; do echo "$p/.MainActivity"; done < "$list"
+elif [ "$2" = resolve-activity ]; then
+	for p; do :; done
+	grep -qx "$p" "$list" && printf 'priority=0 preferredOrder=0 match=0x108000\n%s/.MainActivity\n' "$p"
+fi
+)" },
+	{ "am", R"(#!/bin/sh
+[ "$1" = start ] && echo "Starting: Intent { cmp=$3 }"
+exit 0
+)" },
+	{ "settings", R"(#!/bin/sh
+[ "$1" = put ] && echo "$3=$4" >> "$FAKE_ROOT/.fake/settings"
+exit 0
+)" },
+	{ "setprop", R"(#!/bin/sh
+echo "$1=$2" >> "$FAKE_ROOT/.fake/props"
+)" },
+	{ "getprop", R"(#!/bin/sh
+grep "^$1=" "$FAKE_ROOT/.fake/props" 2>/dev/null | tail -n 1 | cut -d= -f2-
+)" },
+	{ "su", R"(#!/bin/sh
+[ "$FAKE_ROOT_ACCESS" = 1 ] || exit 1
+shift
+exec "$@"
+)" },
+	{ "run-as", R"(#!/bin/sh
+exit 1
+)" },
+	{ "getenforce", R"(#!/bin/sh
+echo Enforcing
+)" },
+	{ "logcat", R"(#!/bin/sh
+cat "$FAKE_ROOT/.fake/logcat.bin" 2>/dev/null
+exit 0
+)" },
+	{ "toybox", R"(#!/bin/sh
+echo cat chmod cp dd df grep ls mkdir mv rm sed sha1sum stat tail truncate
+)" },
+};
+
+bool FakeDevice::Parse(const QString& spec, FakeDevice& device) {
+	// serial[:packages[:state[:model]]], e.g. bench-500:500 or phone:20:unauthorized
+	const QStringList fields = spec.split(':');
+	if (fields.isEmpty() || fields[0].isEmpty())
+		return false;
+
+	device.serial = fields[0].toStdString();
+	if (fields.size() > 1)
+		device.packages = fields[1].toInt();
+	if (fields.size() > 2)
+		device.state = fields[2].toStdString();
+	if (fields.size() > 3)
+		device.model = fields[3].toStdString();
+	return true;
+}
+
+bool FakeDevice::Prepare(const QString& baseDir) {
+	QString name = QString::fromStdString(serial).replace(QRegularExpression("[^A-Za-z0-9._-]"), "_");
+	QDir dir(QDir(baseDir).filePath(name));
+	root = dir.absolutePath();
+
+	for (const char* path : { ".fake/bin", "sdcard/Download", "data/app", "data/local/tmp", "data/user/0", "storage" })
+		if (!dir.mkpath(path))
+			return false;
+
+	for (const auto& stub : STUBS) {
+		QFile f(dir.filePath(QString(".fake/bin/%1").arg(stub[0])));
+		if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+			return false;
+		f.write(stub[1]);
+		f.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner | QFile::ReadGroup | QFile::ExeGroup);
+	}
+
+	QFile list(dir.filePath(".fake/packages"));
+	if (!list.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+	for (int i = 0; i < packages; i++) {
+		const QString package = QString("com.fake.app%1").arg(i);
+		list.write((package + "\n").toUtf8());
+		dir.mkpath(QString("data/app/~~fake==/%1-1==/lib").arg(package));
+	}
+
+	const QString log = dir.filePath(".fake/logcat.bin");
+	QFile::remove(log);
+	return logcat.isEmpty() || QFile::copy(logcat, log);
+}
+
+QString FakeDevice::MapPath(const QString& path) const {
+	return path.startsWith('/') ? root + path : root + "/" + path;
+}
+
+QString FakeDevice::RewriteCommand(const QString& cmd) const {
+	// Absolute device paths appear after whitespace, quotes, '=' or '>'
+	static const QRegularExpression devicePath("(^|[\\s'\"=>])/(sdcard|data|storage)(?=[/\\s'\";]|$)");
+	QString rewritten = cmd;
+	return rewritten.replace(devicePath, "\\1" + root + "/\\2");
+}
+
+QProcessEnvironment FakeDevice::Environment() const {
+	QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+	env.insert("PATH", root + "/.fake/bin:" + env.value("PATH"));
+	env.insert("FAKE_ROOT", root);
+	env.insert("FAKE_ABI", abi);
+	env.insert("FAKE_ROOT_ACCESS", rootAccess ? "1" : "0");
+	return env;
+}
+
+QString FakeDevice::DevicesLine(bool longFormat) const {
+	QString line = QString("%1\t%2").arg(QString::fromStdString(serial), QString::fromStdString(state));
+	if (longFormat)
+		line = QString("%1 product:%2 model:%3 device:%2 transport_id:1")
+			.arg(line, QString::fromStdString(product), QString::fromStdString(model));
+	return line + "\n";
+}
@@ -0,0 +1,58 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QProcessEnvironment>
+
+#include <string>
+
+// A simulated Android device. Its filesystem is a directory on the host:
+// device paths under /sdcard, /data and /storage map into it, and commands
+// run in the host's sh with the Android tools the viewer uses (pm, dumpsys,
+// cmd, am, settings, setprop, su, run-as, ...) replaced by small scripts
+// that answer from files under <root>/.fake. logcat plays back a recorded
+// binary log, copied in from the host file named by logcat.
+class FakeDevice {
+public:
+    std::string serial;
+    std::string state = "device";
+    std::string model = "Fake_Device";
+    std::string product = "fake";
+    int packages = 20;
+    QString abi = "arm64-v8a";
+    bool rootAccess = false;
+    QString logcat;
+    QString root;
+
+    bool Prepare(const QString& baseDir);
+    QString MapPath(const QString& path) const;
+    QString RewriteCommand(const QString& cmd) const;
+    QProcessEnvironment Environment() const;
+    QString DevicesLine(bool longFormat) const;
+
+    static bool Parse(const QString& spec, FakeDevice& device);
+};
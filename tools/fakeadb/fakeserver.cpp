@@ -0,0 +1,498 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include "fakeserver.hpp"
+
+#include <QTcpSocket>
+#include <QProcess>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QRandomGenerator>
+#include <QtEndian>
+
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include "adbclient.hpp"
+
+static const qint64 SYNC_DATA_MAX = 64 * 1024;
+
+// Holds a connection to the configured bandwidth
+class Throttle {
+public:
+	Throttle(qint64 bandwidth) : bandwidth(bandwidth), bytes(0) {
+		timer.start();
+	}
+
+	void consume(qint64 size) {
+		if (bandwidth <= 0)
+			return;
+		bytes += size;
+		const qint64 due = bytes * 1000 / bandwidth;
+		if (due > timer.elapsed())
+			QThread::msleep(due - timer.elapsed());
+	}
+
+private:
+	qint64 bandwidth;
+	qint64 bytes;
+	QElapsedTimer timer;
+};
+
+static bool flush(QTcpSocket& socket) {
+	while (socket.bytesToWrite() > 0) {
+		if (!socket.waitForBytesWritten(-1))
+			return false;
+	}
+	return true;
+}
+
+static bool send(QTcpSocket& socket, const QByteArray& data) {
+	return socket.write(data) == data.size() && flush(socket);
+}
+
+static QByteArray lengthPrefixed(const QByteArray& payload) {
+	return QByteArray::number(payload.size(), 16).rightJustified(4, '0') + payload;
+}
+
+static bool fail(QTcpSocket& socket, const QByteArray& message) {
+	return send(socket, "FAIL" + lengthPrefixed(message));
+}
+
+static bool readRequest(QTcpSocket& socket, QByteArray& request) {
+	char hex[4];
+	if (!AdbClient::ReadExact(socket, hex, sizeof(hex)))
+		return false;
+	bool ok = false;
+	const int length = QByteArray(hex, sizeof(hex)).toInt(&ok, 16);
+	if (!ok)
+		return false;
+	request.resize(length);
+	return AdbClient::ReadExact(socket, request.data(), length);
+}
+
+static QByteArray syncHeader(const char* id, quint32 length) {
+	char header[8];
+	memcpy(header, id, 4);
+	qToLittleEndian<quint32>(length, header + 4);
+	return QByteArray(header, sizeof(header));
+}
+
+static bool syncFail(QTcpSocket& socket, const QByteArray& message) {
+	return send(socket, syncHeader("FAIL", message.size()) + message);
+}
+
+FakeServer::FakeServer(QString baseDir, Options options, QObject* parent)
+	: QTcpServer(parent), baseDir(baseDir), options(options), version(0)
+{
+}
+
+FakeServer::~FakeServer() {
+}
+
+bool FakeServer::AddDevice(FakeDevice device) {
+	if (!device.Prepare(baseDir))
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (FakeDevice& existing : devices) {
+		if (existing.serial == device.serial) {
+			existing = device;
+			version++;
+			return true;
+		}
+	}
+	devices.push_back(device);
+	version++;
+	return true;
+}
+
+bool FakeServer::findDevice(const std::string& serial, FakeDevice& device) {
+	std::lock_guard<std::mutex> lock(mutex);
+	for (const FakeDevice& existing : devices) {
+		if (existing.serial == serial || (serial.empty() && existing.state == "device")) {
+			device = existing;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FakeServer::removeDevice(const std::string& serial) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = std::find_if(devices.begin(), devices.end(), [&serial](const FakeDevice& device) {
+		return device.serial == serial;
+	});
+	if (it == devices.end())
+		return false;
+	devices.erase(it);
+	version++;
+	return true;
+}
+
+bool FakeServer::setState(const std::string& serial, const std::string& state) {
+	std::lock_guard<std::mutex> lock(mutex);
+	for (FakeDevice& device : devices) {
+		if (device.serial == serial) {
+			device.state = state;
+			version++;
+			return true;
+		}
+	}
+	return false;
+}
+
+QByteArray FakeServer::devicesPayload(bool longFormat) {
+	std::lock_guard<std::mutex> lock(mutex);
+	QByteArray payload;
+	for (const FakeDevice& device : devices)
+		payload += device.DevicesLine(longFormat).toUtf8();
+	return payload;
+}
+
+void FakeServer::delay() const {
+	if (options.latencyMs > 0)
+		QThread::msleep(options.latencyMs);
+}
+
+bool FakeServer::shouldFail(const FakeDevice& device) const {
+	if (!options.failDevices.isEmpty() && !options.failDevices.contains(QString::fromStdString(device.serial)))
+		return false;
+	return options.failRate > 0 && QRandomGenerator::global()->generateDouble() < options.failRate;
+}
+
+void FakeServer::incomingConnection(qintptr descriptor) {
+	std::thread([this, descriptor] { serve(descriptor); }).detach();
+}
+
+void FakeServer::serve(qintptr descriptor) {
+	QTcpSocket socket;
+	if (!socket.setSocketDescriptor(descriptor))
+		return;
+
+	FakeDevice transport;
+	QByteArray request;
+	while (readRequest(socket, request)) {
+		delay();
+		if (!request.startsWith("host:")) {
+			if (transport.serial.empty()) {
+				fail(socket, "no transport selected");
+				break;
+			}
+			if (shouldFail(transport))
+				break;
+			serveService(socket, transport, request);
+			break;
+		}
+		if (!hostRequest(socket, request, transport))
+			break;
+	}
+
+	socket.disconnectFromHost();
+	if (socket.state() != QAbstractSocket::UnconnectedState)
+		socket.waitForDisconnected(1000);
+}
+
+// Answers one host request. Returns true only when a transport was selected
+// and the connection goes on with a service request.
+bool FakeServer::hostRequest(QTcpSocket& socket, const QByteArray& request, FakeDevice& transport) {
+	const QByteArray service = request.mid(strlen("host:"));
+
+	if (service == "version") {
+		send(socket, "OKAY" + lengthPrefixed("0029"));
+	}
+	else if (service == "devices" || service == "devices-l") {
+		send(socket, "OKAY" + lengthPrefixed(devicesPayload(service.endsWith("-l"))));
+	}
+	else if (service == "track-devices" || service == "track-devices-l") {
+		trackDevices(socket, service.endsWith("-l"));
+	}
+	else if (service.startsWith("connect:")) {
+		const std::string address = service.mid(strlen("connect:")).toStdString();
+		FakeDevice device;
+		if (!findDevice(address, device)) {
+			device.serial = address;
+			AddDevice(device);
+		}
+		send(socket, "OKAY" + lengthPrefixed("connected to " + QByteArray::fromStdString(address)));
+	}
+	else if (service.startsWith("disconnect:")) {
+		const std::string address = service.mid(strlen("disconnect:")).toStdString();
+		removeDevice(address);
+		send(socket, "OKAY" + lengthPrefixed("disconnected " + QByteArray::fromStdString(address)));
+	}
+	else if (service == "kill") {
+		send(socket, "OKAY");
+		QMetaObject::invokeMethod(QCoreApplication::instance(), &QCoreApplication::quit, Qt::QueuedConnection);
+	}
+	else if (service.startsWith("fake-attach:")) {
+		FakeDevice device;
+		if (FakeDevice::Parse(QString::fromUtf8(service.mid(strlen("fake-attach:"))), device) && AddDevice(device))
+			send(socket, "OKAY");
+		else
+			fail(socket, "bad device spec");
+	}
+	else if (service.startsWith("fake-detach:")) {
+		if (removeDevice(service.mid(strlen("fake-detach:")).toStdString()))
+			send(socket, "OKAY");
+		else
+			fail(socket, "device not found");
+	}
+	else if (service.startsWith("fake-state:")) {
+		const QList<QByteArray> fields = service.mid(strlen("fake-state:")).split(':');
+		if (fields.size() == 2 && setState(fields[0].toStdString(), fields[1].toStdString()))
+			send(socket, "OKAY");
+		else
+			fail(socket, "device not found");
+	}
+	else if (service.startsWith("transport:") || service == "transport-any") {
+		const std::string serial = service.startsWith("transport:") ? service.mid(strlen("transport:")).toStdString() : "";
+		if (!findDevice(serial, transport))
+			fail(socket, "device '" + QByteArray::fromStdString(serial) + "' not found");
+		else if (transport.state != "device")
+			fail(socket, "device " + QByteArray::fromStdString(transport.state));
+		else
+			return send(socket, "OKAY");
+	}
+	else {
+		fail(socket, "unknown host service " + service);
+	}
+	return false;
+}
+
+void FakeServer::trackDevices(QTcpSocket& socket, bool longFormat) {
+	if (!send(socket, "OKAY"))
+		return;
+
+	int sent = -1;
+	while (socket.state() == QAbstractSocket::ConnectedState) {
+		const int current = version;
+		if (current != sent) {
+			if (!send(socket, lengthPrefixed(devicesPayload(longFormat))))
+				return;
+			sent = current;
+		}
+		// Nothing is expected from the client, this only notices it leaving
+		socket.waitForReadyRead(50);
+		socket.readAll();
+	}
+}
+
+void FakeServer::serveService(QTcpSocket& socket, const FakeDevice& device, const QByteArray& service) {
+	if (service == "sync:") {
+		send(socket, "OKAY");
+		serveSync(socket, device);
+		return;
+	}
+
+	// shell[,v2][,raw]:<cmd> and exec:<cmd>
+	const qsizetype colon = service.indexOf(':');
+	const QByteArray name = service.left(colon);
+	const QString cmd = QString::fromUtf8(service.mid(colon + 1));
+	if (colon < 0 || !(name.startsWith("shell") || name == "exec")) {
+		fail(socket, "unknown service " + service);
+		return;
+	}
+
+	send(socket, "OKAY");
+	serveShell(socket, device, cmd, name.split(',').contains("v2"));
+}
+
+void FakeServer::serveShell(QTcpSocket& socket, const FakeDevice& device, const QString& cmd, bool v2) {
+	// An interactive sh gets its command lines rewritten as they arrive
+	const bool interactive = cmd.trimmed().isEmpty() || cmd.trimmed() == "sh";
+
+	QProcess process;
+	process.setProcessEnvironment(device.Environment());
+	process.setWorkingDirectory(device.root);
+	process.setProcessChannelMode(v2 ? QProcess::SeparateChannels : QProcess::MergedChannels);
+	if (interactive)
+		process.start("sh", QStringList());
+	else
+		process.start("sh", { "-c", device.RewriteCommand(cmd) });
+	if (!process.waitForStarted())
+		return;
+
+	Throttle throttle(options.bandwidth);
+	QByteArray input;
+	while (true) {
+		// Client to device
+		if (socket.bytesAvailable() > 0 || socket.waitForReadyRead(1)) {
+			input += socket.readAll();
+			if (v2) {
+				while (input.size() >= 5) {
+					const quint32 length = qFromLittleEndian<quint32>(input.constData() + 1);
+					if (static_cast<quint32>(input.size()) < 5 + length)
+						break;
+					const char id = input[0];
+					const QByteArray data = input.mid(5, length);
+					input.remove(0, 5 + length);
+					throttle.consume(length);
+					if (id == AdbClient::ShellStdin)
+						process.write(data);
+					else if (id == AdbClient::ShellCloseStdin)
+						process.closeWriteChannel();
+				}
+			}
+			else if (interactive) {
+				qsizetype newline;
+				while ((newline = input.indexOf('\n')) >= 0) {
+					const QString line = QString::fromUtf8(input.left(newline));
+					input.remove(0, newline + 1);
+					delay();
+					process.write(device.RewriteCommand(line).toUtf8() + "\n");
+				}
+			}
+			else {
+				throttle.consume(input.size());
+				process.write(input);
+				input.clear();
+			}
+		}
+
+		if (socket.state() != QAbstractSocket::ConnectedState) {
+			process.kill();
+			process.waitForFinished();
+			return;
+		}
+
+		// Device to client
+		process.waitForReadyRead(1);
+		const QByteArray out = process.readAllStandardOutput();
+		const QByteArray err = v2 ? process.readAllStandardError() : QByteArray();
+		if (!out.isEmpty()) {
+			throttle.consume(out.size());
+			if (!(v2 ? AdbClient::WriteShellPacket(socket, AdbClient::ShellStdout, out) : socket.write(out) == out.size()) || !flush(socket))
+				break;
+		}
+		if (!err.isEmpty() && (!AdbClient::WriteShellPacket(socket, AdbClient::ShellStderr, err) || !flush(socket)))
+			break;
+
+		if (process.state() == QProcess::NotRunning && out.isEmpty() && err.isEmpty()
+			&& process.bytesAvailable() == 0) {
+			if (v2) {
+				const char code = static_cast<char>(process.exitStatus() == QProcess::NormalExit ? process.exitCode() : 255);
+				AdbClient::WriteShellPacket(socket, AdbClient::ShellExit, QByteArray(1, code));
+				flush(socket);
+			}
+			return;
+		}
+	}
+
+	process.kill();
+	process.waitForFinished();
+}
+
+void FakeServer::serveSync(QTcpSocket& socket, const FakeDevice& device) {
+	Throttle throttle(options.bandwidth);
+	char header[8];
+	while (AdbClient::ReadExact(socket, header, sizeof(header))) {
+		const QByteArray id(header, 4);
+		const quint32 length = qFromLittleEndian<quint32>(header + 4);
+		QByteArray payload(length, Qt::Uninitialized);
+		if (!AdbClient::ReadExact(socket, payload.data(), length))
+			return;
+		delay();
+
+		if (id == "QUIT")
+			return;
+
+		if (id == "STAT" || id == "STA2" || id == "LST2") {
+			const QFileInfo info(device.MapPath(QString::fromUtf8(payload)));
+			const quint32 mode = !info.exists() ? 0 : info.isDir() ? 040755 : 0100644;
+			const qint64 mtime = info.exists() ? info.lastModified().toSecsSinceEpoch() : 0;
+			if (id == "STAT") {
+				char reply[16];
+				memcpy(reply, "STAT", 4);
+				qToLittleEndian<quint32>(mode, reply + 4);
+				qToLittleEndian<quint32>(static_cast<quint32>(info.size()), reply + 8);
+				qToLittleEndian<quint32>(static_cast<quint32>(mtime), reply + 12);
+				send(socket, QByteArray(reply, sizeof(reply)));
+			}
+			else {
+				char reply[72] = {};
+				memcpy(reply, id.constData(), 4);
+				qToLittleEndian<quint32>(info.exists() ? 0 : 2, reply + 4);
+				qToLittleEndian<quint32>(mode, reply + 24);
+				qToLittleEndian<quint64>(info.exists() ? info.size() : 0, reply + 40);
+				qToLittleEndian<qint64>(mtime, reply + 56);
+				send(socket, QByteArray(reply, sizeof(reply)));
+			}
+		}
+		else if (id == "SEND") {
+			// "<path>,<mode>", data frames follow until DONE
+			const QString path = device.MapPath(QString::fromUtf8(payload.left(payload.lastIndexOf(','))));
+			QDir().mkpath(QFileInfo(path).absolutePath());
+			QFile f(path);
+			if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+				syncFail(socket, "couldn't create file: permission denied");
+				return;
+			}
+
+			QByteArray data;
+			while (true) {
+				if (!AdbClient::ReadExact(socket, header, sizeof(header)))
+					return;
+				const QByteArray frame(header, 4);
+				const quint32 size = qFromLittleEndian<quint32>(header + 4);
+				if (frame == "DONE")
+					break;
+				if (frame != "DATA" || size > SYNC_DATA_MAX) {
+					syncFail(socket, "invalid data message");
+					return;
+				}
+				data.resize(size);
+				if (!AdbClient::ReadExact(socket, data.data(), size))
+					return;
+				throttle.consume(size);
+				f.write(data);
+			}
+			f.close();
+			send(socket, syncHeader("OKAY", 0));
+		}
+		else if (id == "RECV") {
+			QFile f(device.MapPath(QString::fromUtf8(payload)));
+			if (!f.open(QIODevice::ReadOnly)) {
+				syncFail(socket, "No such file or directory");
+				continue;
+			}
+			QByteArray data;
+			while (!(data = f.read(SYNC_DATA_MAX)).isEmpty()) {
+				throttle.consume(data.size());
+				if (!send(socket, syncHeader("DATA", data.size()) + data))
+					return;
+			}
+			send(socket, syncHeader("DONE", 0));
+		}
+		else {
+			syncFail(socket, "unsupported sync request " + id);
+			return;
+		}
+	}
+}
@@ -0,0 +1,89 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#pragma once
+
+#include <QTcpServer>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "fakedevice.hpp"
+
+class QTcpSocket;
+
+// Stand-in for the adb server, speaking the same smart-socket protocol on a
+// localhost port: host:version, host:devices(-l), host:track-devices(-l),
+// host:connect, host:disconnect, host:kill, host:transport and, on a
+// transport, shell (raw and v2), exec and sync. Every connection is served
+// on its own thread with blocking I/O. Latency is added to each request,
+// transfers are held to a bandwidth limit and a share of service requests
+// can be made to fail by dropping the connection, on every device or only
+// on the ones listed in failDevices.
+//
+// host:fake-attach:<spec>, host:fake-detach:<serial> and
+// host:fake-state:<serial>:<state> change the device list at runtime.
+class FakeServer : public QTcpServer {
+    Q_OBJECT
+
+public:
+    struct Options {
+        int latencyMs = 0;
+        qint64 bandwidth = 0;
+        double failRate = 0.0;
+        QStringList failDevices;
+    };
+
+    FakeServer(QString baseDir, Options options, QObject* parent = nullptr);
+    ~FakeServer();
+    bool AddDevice(FakeDevice device);
+
+protected:
+    void incomingConnection(qintptr descriptor) override;
+
+private:
+    void serve(qintptr descriptor);
+    bool hostRequest(QTcpSocket& socket, const QByteArray& request, FakeDevice& transport);
+    void serveService(QTcpSocket& socket, const FakeDevice& device, const QByteArray& service);
+    void serveShell(QTcpSocket& socket, const FakeDevice& device, const QString& cmd, bool v2);
+    void serveSync(QTcpSocket& socket, const FakeDevice& device);
+    void trackDevices(QTcpSocket& socket, bool longFormat);
+    QByteArray devicesPayload(bool longFormat);
+    bool findDevice(const std::string& serial, FakeDevice& device);
+    bool removeDevice(const std::string& serial);
+    bool setState(const std::string& serial, const std::string& state);
+    void delay() const;
+    bool shouldFail(const FakeDevice& device) const;
+
+private:
+    QString baseDir;
+    Options options;
+    std::mutex mutex;
+    std::vector<FakeDevice> devices;
+    std::atomic<int> version;
+};
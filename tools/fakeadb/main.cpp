@@ -0,0 +1,220 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTcpSocket>
+#include <QProcess>
+#include <QFile>
+#include <QDir>
+#include <QThread>
+
+#include <iostream>
+#include <cstring>
+
+#include "adbclient.hpp"
+#include "fakeserver.hpp"
+
+static int usage() {
+	std::cerr <<
+		"usage: fakeadb server [--port N] [--root DIR] [--device SERIAL[:PACKAGES[:STATE[:MODEL]]]]...\n"
+		"                      [--latency MS] [--bandwidth MB/s] [--fail-rate P] [--fail-device SERIAL]...\n"
+		"                      [--root-access] [--logcat FILE]\n"
+		"       fakeadb [-s SERIAL] devices [-l] | connect ADDR | disconnect ADDR | shell CMD...\n"
+		"                           exec-in CMD... | start-server | kill-server\n"
+		"                           attach SPEC | detach SERIAL | set-state SERIAL STATE\n";
+	return 1;
+}
+
+static int runServer(const QStringList& args) {
+	QCommandLineParser parser;
+	parser.addOptions({
+		{ "port", "Port to listen on", "port", "5037" },
+		{ "root", "Directory holding the device filesystems", "dir", QDir::temp().filePath("fakeadb") },
+		{ "device", "Device to simulate", "spec" },
+		{ "latency", "Milliseconds added to every request", "ms", "0" },
+		{ "bandwidth", "Transfer limit per connection in MB/s, 0 for none", "mbps", "0" },
+		{ "fail-rate", "Share of service requests that drop the connection", "p", "0" },
+		{ "fail-device", "Device the fail rate applies to, every device when not given", "serial" },
+		{ "root-access", "Let su succeed on the devices" },
+		{ "logcat", "Binary log (logcat -B) the devices play back", "file" },
+	});
+	parser.process(args);
+
+	FakeServer::Options options;
+	options.latencyMs = parser.value("latency").toInt();
+	options.bandwidth = static_cast<qint64>(parser.value("bandwidth").toDouble() * 1000 * 1000);
+	options.failRate = parser.value("fail-rate").toDouble();
+	options.failDevices = parser.values("fail-device");
+
+	FakeServer server(parser.value("root"), options);
+	QStringList specs = parser.values("device");
+	if (specs.isEmpty())
+		specs << "fake-device";
+	for (const QString& spec : specs) {
+		FakeDevice device;
+		device.rootAccess = parser.isSet("root-access");
+		device.logcat = parser.value("logcat");
+		if (!FakeDevice::Parse(spec, device) || !server.AddDevice(device)) {
+			std::cerr << "fakeadb: cannot create device " << spec.toStdString() << std::endl;
+			return 1;
+		}
+	}
+
+	// The fake runs host commands, never expose it beyond this machine
+	if (!server.listen(QHostAddress::LocalHost, parser.value("port").toUShort())) {
+		std::cerr << "fakeadb: " << server.errorString().toStdString() << std::endl;
+		return 1;
+	}
+	std::cout << "fakeadb listening on 127.0.0.1:" << server.serverPort() << std::endl;
+	return QCoreApplication::exec();
+}
+
+static bool hostRequest(AdbClient& client, const QByteArray& request, QByteArray& reply) {
+	QTcpSocket socket;
+	socket.connectToHost(client.GetHost(), client.GetPort());
+	if (!socket.waitForConnected(2000))
+		return false;
+	socket.write(AdbClient::FormatRequest(request));
+	socket.waitForBytesWritten(2000);
+
+	char status[4];
+	if (!AdbClient::ReadExact(socket, status, sizeof(status), 2000))
+		return false;
+	while (socket.waitForReadyRead(200))
+		;
+	reply = socket.readAll();
+	if (reply.size() >= 4)
+		reply = reply.mid(4);
+	return memcmp(status, "OKAY", 4) == 0;
+}
+
+static int runClient(const QStringList& args) {
+	AdbClient client;
+	std::string serial = qEnvironmentVariable("ANDROID_SERIAL").toStdString();
+	int i = 1;
+	if (args.size() > 2 && args[1] == "-s") {
+		serial = args[2].toStdString();
+		i = 3;
+	}
+	if (i >= args.size())
+		return usage();
+
+	const QString command = args[i];
+	const QStringList rest = args.mid(i + 1);
+	QByteArray reply;
+
+	if (command == "start-server") {
+		if (client.IsAvailable())
+			return 0;
+		QStringList serverArgs = { "server", "--port", QString::number(client.GetPort()) };
+		if (!QProcess::startDetached(QCoreApplication::applicationFilePath(), serverArgs))
+			return 1;
+		for (int attempt = 0; attempt < 50 && !client.IsAvailable(); attempt++)
+			QThread::msleep(100);
+		return client.IsAvailable() ? 0 : 1;
+	}
+	if (command == "kill-server")
+		return hostRequest(client, "host:kill", reply) ? 0 : 1;
+
+	if (command == "devices") {
+		std::vector<AdbClient::Device> devices;
+		if (!client.ListDevices(devices))
+			return 1;
+		std::cout << "List of devices attached" << std::endl;
+		for (const AdbClient::Device& device : devices) {
+			std::cout << device.serial << "\t" << device.state;
+			if (rest.contains("-l"))
+				std::cout << " product:" << device.product << " model:" << device.model << " device:" << device.device;
+			std::cout << std::endl;
+		}
+		return 0;
+	}
+
+	if ((command == "connect" || command == "disconnect") && !rest.isEmpty()) {
+		if (!hostRequest(client, QString("host:%1:%2").arg(command, rest[0]).toUtf8(), reply))
+			return 1;
+		std::cout << reply.toStdString() << std::endl;
+		return 0;
+	}
+	if (command == "attach" && !rest.isEmpty())
+		return hostRequest(client, "host:fake-attach:" + rest[0].toUtf8(), reply) ? 0 : 1;
+	if (command == "detach" && !rest.isEmpty())
+		return hostRequest(client, "host:fake-detach:" + rest[0].toUtf8(), reply) ? 0 : 1;
+	if (command == "set-state" && rest.size() == 2)
+		return hostRequest(client, QString("host:fake-state:%1:%2").arg(rest[0], rest[1]).toUtf8(), reply) ? 0 : 1;
+
+	if (command == "shell") {
+		AdbClient::ShellResult result;
+		if (!client.Shell(serial, rest.join(' '), result))
+			return 1;
+		std::cout << result.out.toStdString();
+		std::cerr << result.err.toStdString();
+		return result.exitCode;
+	}
+
+	if (command == "exec-in" && !rest.isEmpty()) {
+		// Real adb half-closes an exec: socket, which QTcpSocket cannot do, so
+		// stdin goes over shell v2 with an explicit close-stdin packet
+		auto socket = client.OpenService(serial, "shell,v2,raw:" + rest.join(' '));
+		if (!socket)
+			return 1;
+		QFile in;
+		if (!in.open(stdin, QIODevice::ReadOnly))
+			return 1;
+		QByteArray data;
+		while (!(data = in.read(1 << 16)).isEmpty()) {
+			if (!AdbClient::WriteShellPacket(*socket, AdbClient::ShellStdin, data))
+				return 1;
+			while (socket->bytesToWrite() > 0 && socket->waitForBytesWritten(-1))
+				;
+		}
+		AdbClient::WriteShellPacket(*socket, AdbClient::ShellCloseStdin, QByteArray());
+		while (socket->bytesToWrite() > 0 && socket->waitForBytesWritten(-1))
+			;
+
+		char id;
+		while (AdbClient::ReadShellPacket(*socket, id, data)) {
+			if (id == AdbClient::ShellStdout)
+				std::cout << data.toStdString();
+			else if (id == AdbClient::ShellStderr)
+				std::cerr << data.toStdString();
+			else if (id == AdbClient::ShellExit)
+				return data.isEmpty() ? 0 : static_cast<unsigned char>(data[0]);
+		}
+		return 1;
+	}
+
+	return usage();
+}
+
+int main(int argc, char* argv[]) {
+	QCoreApplication app(argc, argv);
+	const QStringList args = app.arguments();
+	if (args.size() < 2)
+		return usage();
+	if (args[1] == "server")
+		return runServer(args.mid(1).prepend(args[0]));
+	return runClient(args);
+}
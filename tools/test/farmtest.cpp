@@ -0,0 +1,192 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+
+// Runs a ReplayFarm against three fakeadb devices that play back a finished
+// replay. Two of them take their jobs through to the end, the third drops
+// every service request through fakeadb's failure injection. Each device has
+// to end with its own status: the healthy ones done with a sample per run,
+// the failing one failed with an error and no jobs done, and the failure
+// must not stop the others.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTemporaryDir>
+#include <QTcpServer>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QRandomGenerator>
+#include <QFile>
+#include <QDir>
+#include <QThread>
+
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "adbclient.hpp"
+#include "replayfarm.hpp"
+
+static const char* REPLAY_PACKAGE = "com.lunarg.gfxreconstruct.replay";
+static const std::vector<std::string> HEALTHY = { "farm-1", "farm-2" };
+static const char* FAILING = "farm-broken";
+
+// Frames and average frame time in the finished replay fixture
+static const uint64_t FRAMES = 60;
+static const double AVG_FRAME_MS = 55.0 / 3;
+
+static int failures = 0;
+
+static void check(bool ok, const QString& what) {
+	if (!ok) {
+		std::cerr << "FAIL " << what.toStdString() << std::endl;
+		failures++;
+	}
+}
+
+static quint16 freePort() {
+	QTcpServer probe;
+	probe.listen(QHostAddress::LocalHost, 0);
+	return probe.serverPort();
+}
+
+static bool writeRandomFile(const QString& path, qint64 size) {
+	QFile f(path);
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+	QByteArray block(size, Qt::Uninitialized);
+	QRandomGenerator::global()->fillRange(reinterpret_cast<quint32*>(block.data()), block.size() / sizeof(quint32));
+	return f.write(block) == block.size();
+}
+
+static void checkHealthy(const std::string& serial, const ReplayFarm::DeviceStatus& device, const QFileInfo& capture, int runs, const QString& devices) {
+	const QString what = QString::fromStdString(serial);
+	check(device.finished, what + ": not finished");
+	check(device.ok, what + ": failed, " + device.error);
+	check(device.error.isEmpty(), what + ": error " + device.error);
+	check(device.jobsDone == device.jobsTotal, what + QString(": %1/%2 jobs done").arg(device.jobsDone).arg(device.jobsTotal));
+
+	auto samples = device.samples.find(capture.fileName());
+	check(samples != device.samples.end() && static_cast<int>(samples->second.size()) == runs,
+		what + QString(": %1 samples").arg(samples == device.samples.end() ? 0 : samples->second.size()));
+	if (samples != device.samples.end()) {
+		for (const ReplayStats::Sample& sample : samples->second) {
+			check(sample.frames == FRAMES, what + QString(": %1 frames").arg(sample.frames));
+			check(std::abs(sample.frameMs - AVG_FRAME_MS) < 1e-3, what + QString(": %1 ms per frame").arg(sample.frameMs));
+		}
+	}
+
+	// The capture is on the device in full
+	const QFileInfo remote(QDir(devices).filePath(QString("%1/data/user/0/%2/files/%3").arg(what, REPLAY_PACKAGE, capture.fileName())));
+	check(remote.size() == capture.size(), what + QString(": %1 bytes on the device").arg(remote.size()));
+}
+
+static void checkFailing(const ReplayFarm::DeviceStatus& device) {
+	const QString what = FAILING;
+	check(device.finished, what + ": not finished");
+	check(!device.ok, what + ": reported ok");
+	check(device.error == "Failed to install replay APK", what + ": error " + device.error);
+	check(device.jobsDone == 0, what + QString(": %1 jobs done").arg(device.jobsDone));
+	check(device.samples.empty(), what + ": has samples");
+}
+
+int main(int argc, char* argv[]) {
+	QCoreApplication app(argc, argv);
+	QStandardPaths::setTestModeEnabled(true);
+
+	QCommandLineParser parser;
+	parser.addHelpOption();
+	parser.addOptions({
+		{ "fakeadb", "Path to the fakeadb executable", "path", "fakeadb" },
+		{ "data", "Directory holding the logcat fixtures", "dir", "." },
+	});
+	parser.process(app);
+
+	QTemporaryDir workDir;
+	if (!workDir.isValid())
+		return 1;
+
+	const quint16 port = freePort();
+	QStringList serverArgs = { "server", "--port", QString::number(port), "--root", workDir.filePath("devices"),
+		"--logcat", QDir(parser.value("data")).filePath("replay-finished.logcat"),
+		"--fail-rate", "1", "--fail-device", FAILING, "--device", FAILING };
+	for (const std::string& serial : HEALTHY)
+		serverArgs << "--device" << QString::fromStdString(serial);
+
+	QProcess server;
+	server.setProcessChannelMode(QProcess::ForwardedChannels);
+	server.start(parser.value("fakeadb"), serverArgs);
+	if (!server.waitForStarted()) {
+		std::cerr << "farmtest: cannot start " << parser.value("fakeadb").toStdString() << std::endl;
+		return 1;
+	}
+
+	qputenv("ADB_SERVER_SOCKET", QString("tcp:127.0.0.1:%1").arg(port).toUtf8());
+	AdbClient client;
+	for (int attempt = 0; attempt < 50 && !client.IsAvailable(); attempt++)
+		QThread::msleep(100);
+
+	// There is no replay APK next to the test, the healthy devices get the
+	// package installed up front and the farm uses it as it is
+	for (const std::string& serial : HEALTHY) {
+		AdbClient::ShellResult result;
+		check(client.Shell(serial, QString("pm install %1.apk").arg(REPLAY_PACKAGE), result) && result.out.contains("Success"),
+			QString("%1: cannot install the replay package").arg(QString::fromStdString(serial)));
+	}
+
+	const QFileInfo capture(workDir.filePath("farm.gfxr"));
+	const QFileInfo second(workDir.filePath("farm2.gfxr"));
+	if (!writeRandomFile(capture.filePath(), 3 << 20) || !writeRandomFile(second.filePath(), 1 << 20))
+		return 1;
+
+	// farm-1 replays the same capture again, which finds it already synced
+	ReplayFarm farm;
+	farm.SetMaxWorkers(3);
+	farm.Enqueue(HEALTHY[0], { capture, QString(), false, 1, QString() });
+	farm.Enqueue(HEALTHY[0], { capture, QString(), false, 2, QString() });
+	farm.Enqueue(HEALTHY[1], { second, QString(), true, 1, QString() });
+	farm.Enqueue(FAILING, { capture, QString(), false, 1, QString() });
+
+	QObject::connect(&farm, &ReplayFarm::Finished, &app, &QCoreApplication::quit);
+	farm.Start();
+	app.exec();
+
+	const std::map<std::string, ReplayFarm::DeviceStatus> status = farm.GetStatus();
+	check(farm.IsFinished(), "farm not finished");
+	check(status.size() == 3, QString("%1 devices in the status").arg(status.size()));
+	if (status.size() == 3) {
+		checkHealthy(HEALTHY[0], status.at(HEALTHY[0]), capture, 3, workDir.filePath("devices"));
+		checkHealthy(HEALTHY[1], status.at(HEALTHY[1]), second, 1, workDir.filePath("devices"));
+		checkFailing(status.at(FAILING));
+	}
+	check(farm.Summary().contains(QString("%1: 0/1 failed, Failed to install replay APK").arg(FAILING)), "summary: " + farm.Summary());
+
+	server.kill();
+	server.waitForFinished();
+
+	std::cout << (failures ? "FAILED" : "OK") << std::endl;
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+/********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 kuloPo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *******************************************************************************/
+
+// Feeds recorded "logcat -B" fixtures through LogcatParser and
+// ReplayMonitor, in one piece and cut at every split size, then plays them
+// back from a fakeadb device through ReplayWatcher. Every path has to end
+// in the same status, and that status has to match what the log says.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTemporaryDir>
+#include <QTcpServer>
+#include <QProcess>
+#include <QRandomGenerator>
+#include <QFile>
+#include <QDir>
+#include <QThread>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "adbclient.hpp"
+#include "logcatparser.hpp"
+#include "replaymonitor.hpp"
+#include "replaywatcher.hpp"
+
+struct Fixture {
+	const char* file;
+	ReplayMonitor::State state;
+	int pid;
+	uint64_t frames;
+	double duration;
+	double minFrameMs;
+	double avgFrameMs;
+	double maxFrameMs;
+	const char* message;
+};
+
+static const Fixture FIXTURES[] = {
+	{ "replay-finished.logcat", ReplayMonitor::State::Finished, 4242, 60, 1.401, 50.0 / 3, 55.0 / 3, 25.0, "Replay finished" },
+	{ "replay-crashed.logcat", ReplayMonitor::State::Crashed, 5151, 30, 1.110, 20.0, 20.0, 20.0, "Fatal signal 11 (SIGSEGV)" },
+};
+
+static const char* SERIAL = "watch-test";
+
+static int failures = 0;
+
+static void check(bool ok, const QString& what) {
+	if (!ok) {
+		std::cerr << "FAIL " << what.toStdString() << std::endl;
+		failures++;
+	}
+}
+
+static bool approx(double a, double b) {
+	return std::abs(a - b) < 1e-3;
+}
+
+static quint16 freePort() {
+	QTcpServer probe;
+	probe.listen(QHostAddress::LocalHost, 0);
+	return probe.serverPort();
+}
+
+static bool sameStatus(const ReplayMonitor::Status& a, const ReplayMonitor::Status& b) {
+	return a.state == b.state && a.pid == b.pid && a.frames == b.frames && approx(a.duration, b.duration) &&
+		approx(a.minFrameMs, b.minFrameMs) && approx(a.avgFrameMs, b.avgFrameMs) && approx(a.maxFrameMs, b.maxFrameMs) &&
+		a.message == b.message;
+}
+
+static void checkStatus(const Fixture& fixture, const ReplayMonitor::Status& status, const QString& path) {
+	const QString what = QString("%1 %2").arg(fixture.file, path);
+	check(status.state == fixture.state, what + ": state");
+	check(status.pid == fixture.pid, what + QString(": pid %1").arg(status.pid));
+	check(status.frames == fixture.frames, what + QString(": %1 frames").arg(status.frames));
+	check(approx(status.duration, fixture.duration), what + QString(": duration %1").arg(status.duration));
+	check(approx(status.minFrameMs, fixture.minFrameMs) && approx(status.avgFrameMs, fixture.avgFrameMs) && approx(status.maxFrameMs, fixture.maxFrameMs),
+		what + QString(": frame times %1 / %2 / %3").arg(status.minFrameMs).arg(status.avgFrameMs).arg(status.maxFrameMs));
+	check(status.message.startsWith(fixture.message), what + ": message " + status.message);
+}
+
+// Every entry as one line, to compare parses of the same log
+static std::vector<std::string> parseEntries(const QByteArray& log, const std::vector<size_t>& cuts) {
+	std::vector<std::string> entries;
+	LogcatParser parser([&](const LogcatParser::Entry& entry) {
+		entries.push_back(std::to_string(entry.pid) + " " + std::to_string(entry.tid) + " " + std::to_string(entry.sec) + "." +
+			std::to_string(entry.nsec) + " " + std::to_string(entry.priority) + " " + std::string(entry.tag) + ": " + std::string(entry.message));
+	});
+	size_t offset = 0;
+	for (size_t cut : cuts) {
+		if (!parser.Feed(log.constData() + offset, cut - offset))
+			entries.push_back("<invalid>");
+		offset = cut;
+	}
+	parser.Feed(log.constData() + offset, log.size() - offset);
+	return entries;
+}
+
+static ReplayMonitor::Status monitor(const QByteArray& log, const std::vector<size_t>& cuts) {
+	ReplayMonitor monitor;
+	size_t offset = 0;
+	for (size_t cut : cuts) {
+		monitor.Feed(log.constData() + offset, cut - offset);
+		offset = cut;
+	}
+	monitor.Feed(log.constData() + offset, log.size() - offset);
+	return monitor.GetStatus();
+}
+
+static void checkCuts(const Fixture& fixture, const QByteArray& log) {
+	const size_t size = log.size();
+	const std::vector<std::string> whole = parseEntries(log, {});
+	const ReplayMonitor::Status status = monitor(log, {});
+	checkStatus(fixture, status, "in one piece");
+
+	// Fixed split sizes, from a byte at a time to the whole log
+	for (size_t step = 1; step <= size; step++) {
+		std::vector<size_t> cuts;
+		for (size_t cut = step; cut < size; cut += step)
+			cuts.push_back(cut);
+		check(parseEntries(log, cuts) == whole, QString("%1 split every %2 bytes: entries differ").arg(fixture.file).arg(step));
+		check(sameStatus(monitor(log, cuts), status), QString("%1 split every %2 bytes: status differs").arg(fixture.file).arg(step));
+	}
+
+	// Arbitrary split sizes, reproducible from the seed
+	QRandomGenerator random(static_cast<quint32>(size));
+	for (int round = 0; round < 1000; round++) {
+		std::vector<size_t> cuts;
+		for (size_t cut = random.bounded(64) + 1; cut < size; cut += random.bounded(64) + 1)
+			cuts.push_back(cut);
+		check(parseEntries(log, cuts) == whole, QString("%1 random split %2: entries differ").arg(fixture.file).arg(round));
+		check(sameStatus(monitor(log, cuts), status), QString("%1 random split %2: status differs").arg(fixture.file).arg(round));
+	}
+}
+
+static void checkWatcher(const Fixture& fixture, const QString& log, const QString& fakeadb) {
+	QTemporaryDir workDir;
+	if (!workDir.isValid()) {
+		check(false, "cannot create a work directory");
+		return;
+	}
+
+	const quint16 port = freePort();
+	QProcess server;
+	server.setProcessChannelMode(QProcess::ForwardedChannels);
+	server.start(fakeadb, { "server", "--port", QString::number(port), "--root", workDir.filePath("devices"),
+		"--device", SERIAL, "--logcat", log });
+	if (!server.waitForStarted()) {
+		check(false, "cannot start " + fakeadb);
+		return;
+	}
+
+	qputenv("ADB_SERVER_SOCKET", QString("tcp:127.0.0.1:%1").arg(port).toUtf8());
+	AdbClient client;
+	for (int attempt = 0; attempt < 50 && !client.IsAvailable(); attempt++)
+		QThread::msleep(100);
+
+	checkStatus(fixture, ReplayWatcher(SERIAL, QString()).Watch(), "through fakeadb");
+
+	server.kill();
+	server.waitForFinished();
+}
+
+int main(int argc, char* argv[]) {
+	QCoreApplication app(argc, argv);
+
+	QCommandLineParser parser;
+	parser.addHelpOption();
+	parser.addOptions({
+		{ "fakeadb", "Path to the fakeadb executable", "path", "fakeadb" },
+		{ "data", "Directory holding the logcat fixtures", "dir", "." },
+	});
+	parser.process(app);
+
+	for (const Fixture& fixture : FIXTURES) {
+		const QString path = QDir(parser.value("data")).filePath(fixture.file);
+		QFile f(path);
+		if (!f.open(QIODevice::ReadOnly)) {
+			check(false, "cannot read " + path);
+			continue;
+		}
+		checkCuts(fixture, f.readAll());
+		checkWatcher(fixture, path, parser.value("fakeadb"));
+	}
+
+	std::cout << (failures ? "FAILED" : "OK") << std::endl;
+	return failures ? 1 : 0;
+}